@@ -8,3 +8,9 @@ set_target_properties(${MEDIPACK_NAME} PROPERTIES
 target_include_directories(${MEDIPACK_NAME}
     INTERFACE ${MEDIPACK_INCLUDE_DIR}
     INTERFACE ${MEDIPACK_SRC_DIR})
+
+if(MEDI_EnableProgressThread)
+  find_package(Threads REQUIRED)
+  set_property(TARGET ${MEDIPACK_NAME} APPEND PROPERTY INTERFACE_LINK_LIBRARIES Threads::Threads)
+  set_property(TARGET ${MEDIPACK_NAME} APPEND PROPERTY INTERFACE_COMPILE_OPTIONS "-DMEDI_EnableProgressThread=true")
+endif()
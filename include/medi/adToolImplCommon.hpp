@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "macros.h"
 #include "typeDefinitions.h"
 #include "adToolInterface.h"
 
@@ -80,5 +81,16 @@ namespace medi {
           buf = NULL;
         }
       }
+
+      // The default ignores the position. Tools that accept beginParallelIndexCreation need to implement it.
+      static inline void registerValueAt(Type& value, PrimalType& oldPrimal, IndexType& index, int position) {
+        MEDI_UNUSED(position);
+        Impl::registerValue(value, oldPrimal, index);
+      }
+
+      static inline void createIndexAt(Type& value, IndexType& index, int position) {
+        MEDI_UNUSED(position);
+        Impl::createIndex(value, index);
+      }
   };
 }
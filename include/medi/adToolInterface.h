@@ -29,6 +29,7 @@
 #pragma once
 
 #include "ampi/op.hpp"
+#include "macros.h"
 #include "typeDefinitions.h"
 
 /**
@@ -38,6 +39,11 @@ namespace medi {
 
   /**
    * @brief The interface for the AD tool that is accessed by MeDiPack.
+   *
+   * With MPI_THREAD_MULTIPLE, MeDiPack calls can be recorded from several threads at the same time. MeDiPack keeps no
+   * shared state on the recording path, the AD tool needs to handle concurrent calls of the interface functions, e.g.
+   * with a tape per thread. The calls of startAssembly, addToolAction and stopAssembly for one handle are always made
+   * by the same thread.
    */
   class ADToolInterface {
 
@@ -98,6 +104,85 @@ namespace medi {
         return adjointMpiType;
       }
 
+      /**
+       * @brief The mpi operator that sums up values of the adjoint mpi type.
+       *
+       * If an operator is provided, the reverse of gather like operations sums the adjoints of all ranks during the
+       * communication. Otherwise the adjoints of all ranks are received and summed with
+       * AdjointInterface::combineAdjoints. The forward evaluation of Reduce_scatter uses the operator in the same way.
+       *
+       * The default implementation provides MPI_SUM for the predefined floating point types.
+       *
+       * @return The sum operator or MPI_OP_NULL if the adjoint mpi type can not be reduced.
+       */
+      virtual MPI_Op getAdjointMpiSumOperator() const {
+        if(MPI_FLOAT == adjointMpiType || MPI_DOUBLE == adjointMpiType || MPI_LONG_DOUBLE == adjointMpiType) {
+          return MPI_SUM;
+        } else {
+          return MPI_OP_NULL;
+        }
+      }
+
+      /**
+       * @brief The mpi operator that sums up values of the primal mpi type.
+       *
+       * Used for the primal reevaluation of sum reductions. Without an operator, the values of all ranks are received
+       * and summed locally. The default implementation provides MPI_SUM for the predefined floating point types.
+       *
+       * @return The sum operator or MPI_OP_NULL if the primal mpi type can not be reduced.
+       */
+      virtual MPI_Op getPrimalMpiSumOperator() const {
+        if(MPI_FLOAT == primalMpiType || MPI_DOUBLE == primalMpiType || MPI_LONG_DOUBLE == primalMpiType) {
+          return MPI_SUM;
+        } else {
+          return MPI_OP_NULL;
+        }
+      }
+
+      /**
+       * @brief Check if the operator is the sum operator.
+       *
+       * @param[in] op  The user operator or an operator that was converted with convertOperator.
+       * @return True if the operator computes the sum of the values.
+       */
+      bool isSumOperator(const AMPI_Op& op) const {
+        if(MPI_SUM == op.primalFunction) {
+          return true;
+        }
+
+        AMPI_Op sum;
+        sum.init(MPI_SUM);
+
+        return convertOperator(sum).primalFunction == op.primalFunction;
+      }
+
+      /**
+       * @brief Prepare the AD tool for the creation of indices from several threads.
+       *
+       * Called before the parallel element loops of createIndices and registerValue, see parallelElementThreshold.
+       * If true is returned, the static createIndexAt and registerValueAt functions are called concurrently for the
+       * given number of values. They get the position of the value in the operation, such that the tool can assign the
+       * indices from a range that is reserved here in the same order as a sequential creation. The range is released
+       * with endParallelIndexCreation.
+       *
+       * The default implementation returns false, the indices are then created sequentially.
+       *
+       * @param[in] count  The number of values that receive an index.
+       * @return True if the indices can be created concurrently.
+       */
+      virtual bool beginParallelIndexCreation(int count) const {
+        MEDI_UNUSED(count);
+
+        return false;
+      }
+
+      /**
+       * @brief Finish the creation of indices from several threads.
+       *
+       * Only called if beginParallelIndexCreation returned true.
+       */
+      virtual void endParallelIndexCreation() const {}
+
       /**
        * @brief If this AD interface represents an AD type.
        * @return true if it is an AD type.
@@ -271,6 +356,24 @@ namespace medi {
        */
       static void createIndex(Type& value, IndexType& index);
 
+      /**
+       * @brief Register an AD value in a parallel index creation, see beginParallelIndexCreation.
+       *
+       * @param[in,out]    value  The AD value in the user buffer on the receiving side.
+       * @param[out]   oldPrimal  The old primal value that was overwritten by this value.
+       * @param[in, out]   index  The identifier registered for the old value.
+       * @param[in]     position  The position of the value in the reserved range, in [0, count).
+       */
+      static void registerValueAt(Type& value, PrimalType& oldPrimal, IndexType& index, int position);
+
+      /**
+       * @brief Create an index in a parallel index creation, see beginParallelIndexCreation.
+       * @param[in,out]    value  The AD value in the buffer.
+       * @param[out]       index  The index for the value.
+       * @param[in]     position  The position of the value in the reserved range, in [0, count).
+       */
+      static void createIndexAt(Type& value, IndexType& index, int position);
+
       /**
        * @brief Get the primal floating point value of the AD value.
        * @param[in] value  The AD value.
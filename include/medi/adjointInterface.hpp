@@ -36,6 +36,33 @@
  */
 namespace medi {
 
+  /**
+   * @brief An update of adjoint variables that is performed after the reverse action has returned.
+   *
+   * See AdjointInterface::deferAdjointUpdate.
+   */
+  class DeferredAdjointUpdate {
+    public:
+
+      virtual ~DeferredAdjointUpdate() {}
+
+      /**
+       * @brief The indices from the AD tool for the variables that are updated.
+       * @return The indices of the variables.
+       */
+      virtual const void* getIndices() const = 0;
+
+      /**
+       * @brief The number of variables that are updated.
+       * @return The number of indices.
+       */
+      virtual int getElements() const = 0;
+
+      /**
+       * @brief Wait for the communication and add the adjoint variables to the ones in the AD tool.
+       */
+      virtual void complete() = 0;
+  };
 
   class AdjointInterface {
     public:
@@ -133,5 +160,21 @@ namespace medi {
        * @param[in]  elements  The number of elements in the vectors.
        */
       virtual void setPrimals(const void* indices, const void* primals, int elements) const = 0;
+
+      /**
+       * @brief Hand over an adjoint update that is still waiting for communication.
+       *
+       * The AD tool can continue with the reverse evaluation. It has to call complete on the update before the adjoint
+       * of one of the indices is read, at the latest at the end of the reverse evaluation. Afterwards the AD tool deletes
+       * the update.
+       *
+       * The default implementation completes the update immediately.
+       *
+       * @param[in] update  The deferred update.
+       */
+      virtual void deferAdjointUpdate(DeferredAdjointUpdate* update) const {
+        update->complete();
+        delete update;
+      }
   };
 }
@@ -0,0 +1,489 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "async.hpp"
+#include "enums.hpp"
+#include "progressThread.hpp"
+#include "sparseEncoding.hpp"
+#include "../macros.h"
+#include "../mpiTools.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Precision of the adjoint values in the messages of the reverse evaluation.
+   */
+  enum class AdjointTransportPrecision {
+    Full,  ///< The adjoint values are communicated with the adjoint MPI type of the AD tool.
+    Float  ///< Adjoint values of type MPI_DOUBLE are communicated as MPI_FLOAT.
+  };
+
+  /**
+   * @brief The key for the adjoint transport precision attribute.
+   *
+   * The attribute is copied to duplicates of the communicator.
+   *
+   * @return The keyval, it is created on the first call.
+   */
+  inline int getAdjointTransportKeyval() {
+    static int keyval = createCommKeyval(MPI_COMM_DUP_FN, MPI_COMM_NULL_DELETE_FN);
+
+    return keyval;
+  }
+
+  /**
+   * @brief Set the precision of the adjoint messages for a communicator.
+   *
+   * The setting applies to the reverse evaluation of all point-to-point and collective operations on the communicator
+   * that are reversed after the call. It needs to be the same on all ranks of the communicator.
+   *
+   * @param[in]      comm  The user communicator.
+   * @param[in] precision  The precision for the adjoint messages.
+   */
+  inline void setAdjointTransportPrecision(MPI_Comm comm, AdjointTransportPrecision precision) {
+    MPI_Comm_set_attr(comm, getAdjointTransportKeyval(), reinterpret_cast<void*>(static_cast<intptr_t>(precision)));
+  }
+
+  /**
+   * @brief Get the precision of the adjoint messages for a communicator.
+   *
+   * @param[in] comm  The user communicator.
+   * @return The precision set with setAdjointTransportPrecision, the default is full precision.
+   */
+  inline AdjointTransportPrecision getAdjointTransportPrecision(MPI_Comm comm) {
+    void* value;
+    int flag;
+    MPI_Comm_get_attr(comm, getAdjointTransportKeyval(), &value, &flag);
+    if(flag) {
+      return static_cast<AdjointTransportPrecision>(reinterpret_cast<intptr_t>(value));
+    } else {
+      return AdjointTransportPrecision::Full;
+    }
+  }
+
+  /**
+   * @brief Counters for the adjoint values that were sent with a reduced precision.
+   */
+  struct AdjointTransportStatistics {
+      LargeCount convertedElements;  ///< Number of adjoint values that were narrowed before they were sent.
+      LargeCount savedBytes;         ///< Size reduction of the narrowed send buffers.
+  };
+
+  /**
+   * @brief Access to the statistics of the reduced precision transport on this rank.
+   *
+   * The statistics are counted per thread, they cover the reverse evaluations of the calling thread.
+   *
+   * @return Reference to the statistics.
+   */
+  inline AdjointTransportStatistics& adjointTransportStatistics() {
+    static thread_local AdjointTransportStatistics statistics = {0, 0};
+
+    return statistics;
+  }
+
+  /**
+   * @brief Set all counters of the reduced precision transport statistics to zero.
+   */
+  inline void resetAdjointTransportStatistics() {
+    adjointTransportStatistics() = {0, 0};
+  }
+
+  /**
+   * @brief Helper function for the number of elements in a buffer that is described by counts and displacements.
+   *
+   * @param[in] counts  The counts for each rank.
+   * @param[in] displs  The displacements for each rank.
+   * @param[in]  ranks  The number of entries in counts and displs.
+   * @return The end of the last block in the buffer.
+   */
+  inline LargeCount computeDisplacedElements(const int* counts, const int* displs, int ranks) {
+    LargeCount elements = 0;
+    for(int i = 0; i < ranks; ++i) {
+      if(0 != counts[i] && elements < (LargeCount)displs[i] + counts[i]) {
+        elements = (LargeCount)displs[i] + counts[i];
+      }
+    }
+
+    return elements;
+  }
+
+  /**
+   * @brief Buffer, count and type for the MPI call of a point-to-point adjoint message.
+   */
+  struct AdjointMessage {
+      void* buf;
+      LargeCount count;
+      MPI_Datatype type;
+  };
+
+  /**
+   * @brief Send an adjoint message with the blocking MPI send function of the reverse call.
+   *
+   * @param[in]     message  The message from AdjointTransport::sendMessage.
+   * @param[in] reverseCall  The send mode of the reverse of the receive.
+   * @param[in]        dest  The destination rank.
+   * @param[in]         tag  The message tag.
+   * @param[in]        comm  The MPI communicator for the message.
+   */
+  inline void sendAdjointMessage(const AdjointMessage& message, RecvAdjCall reverseCall, int dest, int tag,
+                                 MPI_Comm comm) {
+    LargeCountType bufType(message.count, message.type);
+    if (RecvAdjCall::Send == reverseCall) {
+      MPI_Send(message.buf, bufType.count, bufType.type, dest, tag, comm);
+    } else if (RecvAdjCall::Bsend == reverseCall) {
+      MPI_Bsend(message.buf, bufType.count, bufType.type, dest, tag, comm);
+    } else if (RecvAdjCall::Rsend == reverseCall) {
+      MPI_Rsend(message.buf, bufType.count, bufType.type, dest, tag, comm);
+    } else if (RecvAdjCall::Ssend == reverseCall) {
+      MPI_Ssend(message.buf, bufType.count, bufType.type, dest, tag, comm);
+    } else {
+      MEDI_EXCEPTION("Unimplemented case for RecvAdjCall %d.", (int)reverseCall);
+    }
+  }
+
+  /**
+   * @brief Send an adjoint message with the non-blocking MPI send function of the reverse call.
+   *
+   * @param[in]     message  The message from AdjointTransport::sendMessage.
+   * @param[in] reverseCall  The send mode of the reverse of the receive.
+   * @param[in]        dest  The destination rank.
+   * @param[in]         tag  The message tag.
+   * @param[in]        comm  The MPI communicator for the message.
+   * @param[out]    request  The request of the send.
+   */
+  inline void isendAdjointMessage(const AdjointMessage& message, IrecvAdjCall reverseCall, int dest, int tag,
+                                  MPI_Comm comm, MPI_Request* request) {
+    LargeCountType bufType(message.count, message.type);
+    if (IrecvAdjCall::Isend == reverseCall) {
+      MPI_Isend(message.buf, bufType.count, bufType.type, dest, tag, comm, request);
+    } else if (IrecvAdjCall::Ibsend == reverseCall) {
+      MPI_Ibsend(message.buf, bufType.count, bufType.type, dest, tag, comm, request);
+    } else if (IrecvAdjCall::Irsend == reverseCall) {
+      MPI_Irsend(message.buf, bufType.count, bufType.type, dest, tag, comm, request);
+    } else if (IrecvAdjCall::Issend == reverseCall) {
+      MPI_Issend(message.buf, bufType.count, bufType.type, dest, tag, comm, request);
+    } else {
+      MEDI_EXCEPTION("Unimplemented case for IrecvAdjCall %d.", (int)reverseCall);
+    }
+  }
+
+  /**
+   * @brief The non-blocking send mode for a blocking send mode.
+   * @param[in] reverseCall  The blocking send mode.
+   * @return The non-blocking counterpart.
+   */
+  inline IrecvAdjCall getNonBlockingCall(RecvAdjCall reverseCall) {
+    if (RecvAdjCall::Bsend == reverseCall) {
+      return IrecvAdjCall::Ibsend;
+    } else if (RecvAdjCall::Rsend == reverseCall) {
+      return IrecvAdjCall::Irsend;
+    } else if (RecvAdjCall::Ssend == reverseCall) {
+      return IrecvAdjCall::Issend;
+    } else {
+      return IrecvAdjCall::Isend;
+    }
+  }
+
+  /**
+   * @brief Conversion of the adjoint buffers of one reverse communication to the transport precision.
+   *
+   * Send buffers are narrowed in place before the MPI call, the values are stored contiguously at the start of the
+   * buffer. The MPI call uses the wire type for the counts and displacements, the layout of the blocks therefore
+   * matches the narrowed buffer. After the communication has completed, all registered buffers are widened in place.
+   *
+   * Only adjoint types that are MPI_DOUBLE are reduced. For all other types and in the full precision mode, the
+   * buffers are not converted.
+   *
+   * Point-to-point messages are in addition encoded with sendMessage and recvMessage if the sparse encoding is
+   * enabled, see adjointSparseDensity. Received messages are decoded in finish before the buffers are widened.
+   */
+  struct AdjointTransport {
+    private:
+      static const int MAX_BUFFERS = 2;
+
+      void* buffers[MAX_BUFFERS];
+      LargeCount sizes[MAX_BUFFERS];
+      int bufferCount;
+
+      std::vector<char> encoded;
+      void* decodeBuf;
+      LargeCount decodeElements;
+      int decodeElementBytes;
+
+    public:
+
+      bool isReduced;
+
+      /**
+       * @brief Decide on the transport for a communication with one adjoint type.
+       *
+       * @param[in]        comm  The user communicator.
+       * @param[in] adjointType  The adjoint MPI type of the AD tool.
+       */
+      AdjointTransport(MPI_Comm comm, MPI_Datatype adjointType) :
+        AdjointTransport(comm, adjointType, adjointType) {}
+
+      /**
+       * @brief Decide on the transport for a communication with a send and a receive type.
+       *
+       * @param[in]            comm  The user communicator.
+       * @param[in] sendAdjointType  The adjoint MPI type of the send type.
+       * @param[in] recvAdjointType  The adjoint MPI type of the receive type.
+       */
+      AdjointTransport(MPI_Comm comm, MPI_Datatype sendAdjointType, MPI_Datatype recvAdjointType) :
+        buffers(),
+        sizes(),
+        bufferCount(0),
+        encoded(),
+        decodeBuf(nullptr),
+        decodeElements(0),
+        decodeElementBytes(0),
+        isReduced(MPI_DOUBLE == sendAdjointType && MPI_DOUBLE == recvAdjointType &&
+                  AdjointTransportPrecision::Float == getAdjointTransportPrecision(comm)) {}
+
+      /**
+       * @brief The type for the MPI call.
+       *
+       * @param[in] adjointType  The adjoint MPI type of the AD tool.
+       * @return MPI_FLOAT if the transport is reduced, otherwise the adjoint type.
+       */
+      MPI_Datatype wireType(MPI_Datatype adjointType) const {
+        return isReduced ? MPI_FLOAT : adjointType;
+      }
+
+      /**
+       * @brief Narrow a buffer that is sent.
+       *
+       * @param[in,out]      buf  The adjoint buffer.
+       * @param[in]     elements  The number of adjoint values in the buffer.
+       */
+      void send(void* buf, LargeCount elements) {
+        if(isReduced && addBuffer(buf, elements)) {
+          narrow(buf, elements);
+
+          AdjointTransportStatistics& statistics = adjointTransportStatistics();
+          statistics.convertedElements += elements;
+          statistics.savedBytes += elements * (LargeCount)(sizeof(double) - sizeof(float));
+        }
+      }
+
+      /**
+       * @brief Narrow a buffer that is sent and is described by counts and displacements.
+       *
+       * @param[in,out]        buf  The adjoint buffer.
+       * @param[in]         counts  The counts for each rank.
+       * @param[in]         displs  The displacements for each rank.
+       * @param[in]          ranks  The number of entries in counts and displs.
+       * @param[in]     vectorSize  The number of adjoint values for each element of counts and displs.
+       */
+      void send(void* buf, const int* counts, const int* displs, int ranks, int vectorSize) {
+        if(isReduced) {
+          send(buf, computeDisplacedElements(counts, displs, ranks) * vectorSize);
+        }
+      }
+
+      /**
+       * @brief Register a buffer that is received, it is widened in finish.
+       *
+       * @param[in]      buf  The adjoint buffer.
+       * @param[in] elements  The number of adjoint values in the buffer.
+       */
+      void recv(void* buf, LargeCount elements) {
+        if(isReduced) {
+          addBuffer(buf, elements);
+        }
+      }
+
+      /**
+       * @brief Register a buffer that is received and is described by counts and displacements.
+       *
+       * @param[in]        buf  The adjoint buffer.
+       * @param[in]     counts  The counts for each rank.
+       * @param[in]     displs  The displacements for each rank.
+       * @param[in]      ranks  The number of entries in counts and displs.
+       * @param[in] vectorSize  The number of adjoint values for each element of counts and displs.
+       */
+      void recv(void* buf, const int* counts, const int* displs, int ranks, int vectorSize) {
+        if(isReduced) {
+          recv(buf, computeDisplacedElements(counts, displs, ranks) * vectorSize);
+        }
+      }
+
+      /**
+       * @brief Narrow and encode the buffer of a point-to-point message that is sent.
+       *
+       * @param[in,out]      buf  The adjoint buffer.
+       * @param[in]     elements  The number of adjoint values in the buffer.
+       * @param[in]  adjointType  The adjoint MPI type of the AD tool.
+       * @return The arguments for the MPI call.
+       */
+      AdjointMessage sendMessage(void* buf, LargeCount elements, MPI_Datatype adjointType) {
+        send(buf, elements);
+
+        MPI_Datatype type = wireType(adjointType);
+        int elementBytes = getSparseEncodingElementBytes(type);
+        if(0 == elementBytes) {
+          return AdjointMessage{buf, elements, type};
+        }
+
+        encoded.resize(getMaxEncodedBytes(elements, elementBytes));
+        LargeCount bytes = encodeAdjoints(buf, elements, elementBytes, encoded.data());
+
+        return AdjointMessage{encoded.data(), bytes, MPI_BYTE};
+      }
+
+      /**
+       * @brief Register the buffer of a point-to-point message that is received, it is decoded and widened in finish.
+       *
+       * @param[in]         buf  The adjoint buffer.
+       * @param[in]    elements  The number of adjoint values in the buffer.
+       * @param[in] adjointType  The adjoint MPI type of the AD tool.
+       * @return The arguments for the MPI call.
+       */
+      AdjointMessage recvMessage(void* buf, LargeCount elements, MPI_Datatype adjointType) {
+        recv(buf, elements);
+
+        MPI_Datatype type = wireType(adjointType);
+        int elementBytes = getSparseEncodingElementBytes(type);
+        if(0 == elementBytes) {
+          return AdjointMessage{buf, elements, type};
+        }
+
+        LargeCount bytes = getMaxEncodedBytes(elements, elementBytes);
+        encoded.resize(bytes);
+        decodeBuf = buf;
+        decodeElements = elements;
+        decodeElementBytes = elementBytes;
+
+        return AdjointMessage{encoded.data(), bytes, MPI_BYTE};
+      }
+
+      /**
+       * @brief Decode and widen all registered buffers, the communication needs to be completed.
+       */
+      void finish() {
+        if(nullptr != decodeBuf) {
+          decodeAdjoints(encoded.data(), decodeBuf, decodeElements, decodeElementBytes);
+          decodeBuf = nullptr;
+        }
+
+        for(int i = 0; i < bufferCount; ++i) {
+          widen(buffers[i], sizes[i]);
+        }
+        bufferCount = 0;
+      }
+
+      /**
+       * @brief Decode and widen all registered buffers after the request has been completed in the reverse evaluation.
+       *
+       * The encoded message is kept alive until then. The conversion is performed by the progress thread if it is
+       * running, see progressThreadEnabled.
+       *
+       * @param[in,out] request  The request of the non-blocking reverse communication.
+       */
+      void finish(AMPI_Request* request) {
+        if(0 != bufferCount || !encoded.empty()) {
+          request->setCompletionData(reinterpret_cast<void*>(new AdjointTransport(std::move(*this))),
+                                     AdjointTransport::finishFunc);
+          addReverseCompletion(request);
+          bufferCount = 0;
+          decodeBuf = nullptr;
+        }
+      }
+
+      /**
+       * @brief Completion function for requests, see finish(AMPI_Request*).
+       */
+      static void finishFunc(void* data) {
+        AdjointTransport* transport = reinterpret_cast<AdjointTransport*>(data);
+        transport->finish();
+
+        delete transport;
+      }
+
+    private:
+
+      bool addBuffer(void* buf, LargeCount elements) {
+        if(nullptr == buf || 0 >= elements) {
+          return false;
+        }
+
+        for(int i = 0; i < bufferCount; ++i) {
+          if(buf == buffers[i]) {
+            if(sizes[i] < elements) {
+              sizes[i] = elements;
+            }
+            return false;
+          }
+        }
+
+        mediAssert(bufferCount < MAX_BUFFERS);
+        buffers[bufferCount] = buf;
+        sizes[bufferCount] = elements;
+        bufferCount += 1;
+
+        return true;
+      }
+
+      static void narrow(void* buf, LargeCount elements) {
+        char* data = reinterpret_cast<char*>(buf);
+
+        // The write position is never behind the read position.
+        for(LargeCount i = 0; i < elements; ++i) {
+          double value;
+          std::memcpy(&value, data + i * sizeof(double), sizeof(double));
+          float narrowed = (float)value;
+          std::memcpy(data + i * sizeof(float), &narrowed, sizeof(float));
+        }
+      }
+
+      static void widen(void* buf, LargeCount elements) {
+        char* data = reinterpret_cast<char*>(buf);
+
+        // Backwards, so that the unread values are not overwritten.
+        for(LargeCount i = elements - 1; i >= 0; --i) {
+          float value;
+          std::memcpy(&value, data + i * sizeof(float), sizeof(float));
+          double widened = (double)value;
+          std::memcpy(data + i * sizeof(double), &widened, sizeof(double));
+        }
+      }
+  };
+}
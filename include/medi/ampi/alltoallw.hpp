@@ -0,0 +1,915 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#pragma once
+
+#include "async.hpp"
+#include "ampiMisc.h"
+#include "typeInterface.hpp"
+#include "../adjointInterface.hpp"
+#include "../exceptions.hpp"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Select the AD tool of the first active type in the per peer type arrays.
+   *
+   * @param[in] sendtypes  The send types for each rank.
+   * @param[in] recvtypes  The receive types for each rank.
+   * @param[in]     ranks  The number of ranks in the communicator.
+   * @return The AD tool of the first active type or the one of the first send type if no type is active.
+   */
+  inline ADToolInterface const* selectADTool(MpiTypeInterface* const* sendtypes, MpiTypeInterface* const* recvtypes,
+                                             int ranks) {
+    for(int i = 0; i < ranks; ++i) {
+      if(sendtypes[i]->getADTool().isActiveType()) {
+        return &sendtypes[i]->getADTool();
+      }
+      if(recvtypes[i]->getADTool().isActiveType()) {
+        return &recvtypes[i]->getADTool();
+      }
+    }
+
+    return &sendtypes[0]->getADTool();
+  }
+
+  /**
+   * @brief Select the AD tool of the first active type for a neighborhood collective.
+   *
+   * The number of send and receive types differ, since they are given by the out and in degree of the topology.
+   *
+   * @param[in] sendtypes  The send types for each destination neighbor.
+   * @param[in] sendRanks  The number of destination neighbors.
+   * @param[in] recvtypes  The receive types for each source neighbor.
+   * @param[in] recvRanks  The number of source neighbors.
+   * @return The AD tool of the first active type, the one of the first type if no type is active or nullptr if the
+   *         process has no neighbors.
+   */
+  inline ADToolInterface const* selectADTool(MpiTypeInterface* const* sendtypes, int sendRanks,
+                                             MpiTypeInterface* const* recvtypes, int recvRanks) {
+    for(int i = 0; i < sendRanks; ++i) {
+      if(sendtypes[i]->getADTool().isActiveType()) {
+        return &sendtypes[i]->getADTool();
+      }
+    }
+    for(int i = 0; i < recvRanks; ++i) {
+      if(recvtypes[i]->getADTool().isActiveType()) {
+        return &recvtypes[i]->getADTool();
+      }
+    }
+
+    if(0 != sendRanks) {
+      return &sendtypes[0]->getADTool();
+    } else if(0 != recvRanks) {
+      return &recvtypes[0]->getADTool();
+    } else {
+      return nullptr;
+    }
+  }
+
+  /**
+   * @brief The user arguments of one side of an Alltoallw call and the arguments for the MPI call.
+   *
+   * Alltoallw provides the displacements in bytes. MeDiPack addresses the buffers in elements of the types, the block
+   * of each rank is therefore given by its own start address in the user buffer. The displacements do not need to be
+   * a multiple of the type extent. Neighbor_alltoallw provides the displacements as MPI_Aint, the displacements for
+   * the MPI call are available in both types.
+   *
+   * If one of the types requires a modified buffer, each rank gets its own modified buffer. These buffers are
+   * communicated with datatypes that contain the absolute address of the buffer, that is relative to MPI_BOTTOM.
+   *
+   * MPI does not access the blocks of the neighbors that are MPI_PROC_NULL. Their counts are set to zero, so they get
+   * no AD data and keep their values.
+   */
+  struct AlltoallwArguments {
+      int ranks;
+      void* buf;
+      MpiTypeInterface** types;
+      int* counts;
+      void** bufs;
+      void** bufMod;
+
+      void* mpiBuf;
+      int* mpiCounts;
+      int* mpiDispls;
+      MPI_Aint* mpiByteDispls;
+      MPI_Datatype* mpiTypes;
+
+      template<typename Displ>
+      AlltoallwArguments(int ranks, const void* buf, const int* counts, const Displ* displs,
+                         MpiTypeInterface* const* types, MPI_Comm neighborComm = MPI_COMM_NULL) :
+        ranks(ranks),
+        buf(const_cast<void*>(buf)),
+        types(new MpiTypeInterface*[ranks]),
+        counts(new int[ranks]),
+        bufs(new void*[ranks]),
+        bufMod(nullptr),
+        mpiBuf(const_cast<void*>(buf)),
+        mpiCounts(new int[ranks]),
+        mpiDispls(new int[ranks]),
+        mpiByteDispls(new MPI_Aint[ranks]),
+        mpiTypes(new MPI_Datatype[ranks]) {
+
+        bool modifiedBufferRequired = false;
+        for(int i = 0; i < ranks; ++i) {
+          this->types[i] = types[i];
+          this->counts[i] = counts[i];
+          this->bufs[i] = reinterpret_cast<char*>(this->buf) + displs[i];
+          if(MPI_COMM_NULL != neighborComm && isProcNullNeighbor(neighborComm, i)) {
+            this->counts[i] = 0;
+          }
+
+          mpiCounts[i] = this->counts[i];
+          mpiDispls[i] = (int)displs[i];
+          mpiByteDispls[i] = (MPI_Aint)displs[i];
+          mpiTypes[i] = types[i]->getModifiedMpiType();
+          modifiedBufferRequired |= types[i]->isModifiedBufferRequired();
+        }
+
+        if(modifiedBufferRequired) {
+          bufMod = new void*[ranks];
+          mpiBuf = MPI_BOTTOM;
+          for(int i = 0; i < ranks; ++i) {
+            bufMod[i] = nullptr;
+            if(this->types[i]->isModifiedBufferRequired()) {
+              this->types[i]->createModifiedTypeBuffer(bufMod[i], this->counts[i]);
+            } else {
+              bufMod[i] = this->bufs[i];
+            }
+
+            mpiDispls[i] = 0;
+            mpiByteDispls[i] = 0;
+            if(0 != this->counts[i]) {
+              MPI_Aint address;
+              MPI_Get_address(bufMod[i], &address);
+              MPI_Type_create_hindexed(1, &this->counts[i], &address, this->types[i]->getModifiedMpiType(),
+                                       &mpiTypes[i]);
+              MPI_Type_commit(&mpiTypes[i]);
+              mpiCounts[i] = 1;
+            }
+          }
+        }
+      }
+
+      ~AlltoallwArguments() {
+        if(nullptr != bufMod) {
+          for(int i = 0; i < ranks; ++i) {
+            if(types[i]->isModifiedBufferRequired()) {
+              types[i]->deleteModifiedTypeBuffer(bufMod[i]);
+            }
+            if(0 != counts[i]) {
+              MPI_Type_free(&mpiTypes[i]);
+            }
+          }
+          delete [] bufMod;
+        }
+
+        delete [] types;
+        delete [] counts;
+        delete [] bufs;
+        delete [] mpiCounts;
+        delete [] mpiDispls;
+        delete [] mpiByteDispls;
+        delete [] mpiTypes;
+      }
+
+      /**
+       * @brief Copy the user data into the modified buffers.
+       */
+      void copyIntoModifiedBuffer() {
+        if(nullptr != bufMod) {
+          for(int i = 0; i < ranks; ++i) {
+            if(types[i]->isModifiedBufferRequired()) {
+              types[i]->copyIntoModifiedBuffer(bufs[i], 0, bufMod[i], 0, counts[i]);
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Copy the received data from the modified buffers into the user buffer.
+       */
+      void copyFromModifiedBuffer() {
+        if(nullptr != bufMod) {
+          for(int i = 0; i < ranks; ++i) {
+            if(types[i]->isModifiedBufferRequired()) {
+              types[i]->copyFromModifiedBuffer(bufs[i], 0, bufMod[i], 0, counts[i]);
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Clear the AD data of the receive buffer if it is received without a modified buffer.
+       */
+      void clearIndices() {
+        for(int i = 0; i < ranks; ++i) {
+          if(!types[i]->isModifiedBufferRequired()) {
+            types[i]->clearIndices(bufs[i], 0, counts[i]);
+          }
+        }
+      }
+  };
+
+  /**
+   * @brief The AD data of one side of an Alltoallw call.
+   *
+   * The types of the ranks differ, therefore the indices and old primal values are stored for each rank. The primal
+   * and adjoint values of all ranks are stored linearly in one buffer of the AD tool type. The reverse communication
+   * is then an Alltoallv on the primal or adjoint MPI type of the AD tool. The counts and displacements are given in
+   * active elements, in the vector mode the values of one element are described by a VectorType.
+   */
+  struct AlltoallwADData {
+      int ranks;
+      MpiTypeInterface** types;
+      int* activeCounts;
+      int* activeDispls;
+      void** indices;
+      void** oldPrimals;
+
+      /* required for async */ VectorType* valueType;
+      /* required for async */ void* values;
+
+      AlltoallwADData() :
+        ranks(0),
+        types(nullptr),
+        activeCounts(nullptr),
+        activeDispls(nullptr),
+        indices(nullptr),
+        oldPrimals(nullptr),
+        valueType(nullptr),
+        values(nullptr) {}
+
+      ~AlltoallwADData() {
+        for(int i = 0; i < ranks; ++i) {
+          if(nullptr != indices[i]) {
+            types[i]->getADTool().deleteIndexTypeBuffer(indices[i]);
+          }
+          if(nullptr != oldPrimals[i]) {
+            types[i]->getADTool().deletePrimalTypeBuffer(oldPrimals[i]);
+          }
+        }
+
+        delete [] types;
+        delete [] activeCounts;
+        delete [] activeDispls;
+        delete [] indices;
+        delete [] oldPrimals;
+      }
+
+      /**
+       * @brief Create the index buffers for all ranks.
+       * @param[in] args  The arguments of the call.
+       */
+      void init(AlltoallwArguments const& args) {
+        ranks = args.ranks;
+        types = new MpiTypeInterface*[ranks];
+        activeCounts = new int[ranks];
+        activeDispls = new int[ranks + 1];
+        indices = new void*[ranks];
+        oldPrimals = new void*[ranks];
+
+        LargeCount totalSize = 0;
+        for(int i = 0; i < ranks; ++i) {
+          types[i] = args.types[i];
+          activeCounts[i] = types[i]->computeActiveElements(args.counts[i]);
+          activeDispls[i] = (int)totalSize;
+          totalSize += activeCounts[i];
+          oldPrimals[i] = nullptr;
+          types[i]->getADTool().createIndexTypeBuffer(indices[i], activeCounts[i]);
+        }
+
+        if(totalSize > INT_MAX) {
+          MEDI_EXCEPTION("The %lld active elements of all ranks exceed the range of the displacements.",
+                         (long long)totalSize);
+        }
+        activeDispls[ranks] = (int)totalSize;
+      }
+
+      /**
+       * @brief The total number of active elements of all ranks.
+       * @return The size of the linear value buffers.
+       */
+      int getTotalSize() const {
+        return activeDispls[ranks];
+      }
+
+      /**
+       * @brief The number of values in the linear value buffers.
+       * @param[in] vecSize  The number of values for each active element.
+       * @return The size of the linear value buffers.
+       */
+      size_t getValueSize(int vecSize) const {
+        return (size_t)getTotalSize() * vecSize;
+      }
+
+      /**
+       * @brief Create the MPI type for one active element in the linear value buffers.
+       * @param[in]  vecSize  The number of values for each active element.
+       * @param[in] baseType  The primal or adjoint MPI type of the AD tool.
+       */
+      void createValueType(int vecSize, MPI_Datatype baseType) {
+        valueType = new VectorType(vecSize, baseType);
+      }
+
+      /**
+       * @brief Delete the MPI type for the linear value buffers.
+       */
+      void deleteValueType() {
+        delete valueType;
+        valueType = nullptr;
+      }
+
+      /**
+       * @brief The position of the values of a rank in the linear value buffer.
+       * @param[in] rank  The rank in the argument arrays.
+       * @return The start of the values of the rank.
+       */
+      void* getValues(int rank) const {
+        return shiftBuffer(values, activeDispls[rank], valueType->type);
+      }
+  };
+
+  struct AMPI_Alltoallw_AdjointHandle : public AsyncAdjointHandle {
+      ADToolInterface const* adType;
+      AlltoallwADData sendbuf;
+      AlltoallwADData recvbuf;
+      AMPI_Comm comm;
+      AMPI_Comm reverseComm;
+  };
+
+  struct AMPI_Ialltoallw_AsyncHandle : public AsyncHandle {
+      AlltoallwArguments* sendArgs;
+      AlltoallwArguments* recvArgs;
+      MPI_Datatype* passiveTypes;
+  };
+
+  inline void AMPI_Alltoallw_p_start(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    MPI_Datatype primalType = h->adType->getPrimalMpiType();
+
+    h->sendbuf.createValueType(1, primalType);
+    h->recvbuf.createValueType(1, primalType);
+    adjointInterface->createPrimalTypeBuffer(h->sendbuf.values, h->sendbuf.getValueSize(1));
+    adjointInterface->createPrimalTypeBuffer(h->recvbuf.values, h->recvbuf.getValueSize(1));
+    for(int i = 0; i < h->sendbuf.ranks; ++i) {
+      adjointInterface->getPrimals(h->sendbuf.indices[i], h->sendbuf.getValues(i), h->sendbuf.activeCounts[i]);
+    }
+  }
+
+  inline void AMPI_Alltoallw_p_end(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    adjointInterface->deletePrimalTypeBuffer(h->sendbuf.values);
+    for(int i = 0; i < h->recvbuf.ranks; ++i) {
+      if(h->adType->isOldPrimalsRequired()) {
+        adjointInterface->getPrimals(h->recvbuf.indices[i], h->recvbuf.oldPrimals[i], h->recvbuf.activeCounts[i]);
+      }
+      adjointInterface->setPrimals(h->recvbuf.indices[i], h->recvbuf.getValues(i), h->recvbuf.activeCounts[i]);
+    }
+    adjointInterface->deletePrimalTypeBuffer(h->recvbuf.values);
+    h->sendbuf.deleteValueType();
+    h->recvbuf.deleteValueType();
+  }
+
+  inline void AMPI_Alltoallw_d_start(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    MPI_Datatype adjointType = h->adType->getAdjointMpiType();
+    int vecSize = adjointInterface->getVectorSize();
+
+    h->sendbuf.createValueType(vecSize, adjointType);
+    h->recvbuf.createValueType(vecSize, adjointType);
+    adjointInterface->createAdjointTypeBuffer(h->sendbuf.values, h->sendbuf.getValueSize(vecSize));
+    adjointInterface->createAdjointTypeBuffer(h->recvbuf.values, h->recvbuf.getValueSize(vecSize));
+    for(int i = 0; i < h->sendbuf.ranks; ++i) {
+      adjointInterface->getAdjoints(h->sendbuf.indices[i], h->sendbuf.getValues(i), h->sendbuf.activeCounts[i]);
+    }
+  }
+
+  inline void AMPI_Alltoallw_d_end(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbuf.values);
+    for(int i = 0; i < h->recvbuf.ranks; ++i) {
+      adjointInterface->updateAdjoints(h->recvbuf.indices[i], h->recvbuf.getValues(i), h->recvbuf.activeCounts[i]);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbuf.values);
+    h->sendbuf.deleteValueType();
+    h->recvbuf.deleteValueType();
+  }
+
+  inline void AMPI_Alltoallw_b_start(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    MPI_Datatype adjointType = h->adType->getAdjointMpiType();
+    int vecSize = adjointInterface->getVectorSize();
+
+    h->sendbuf.createValueType(vecSize, adjointType);
+    h->recvbuf.createValueType(vecSize, adjointType);
+    adjointInterface->createAdjointTypeBuffer(h->recvbuf.values, h->recvbuf.getValueSize(vecSize));
+    for(int i = 0; i < h->recvbuf.ranks; ++i) {
+      adjointInterface->getAdjoints(h->recvbuf.indices[i], h->recvbuf.getValues(i), h->recvbuf.activeCounts[i]);
+      if(h->adType->isOldPrimalsRequired()) {
+        adjointInterface->setPrimals(h->recvbuf.indices[i], h->recvbuf.oldPrimals[i], h->recvbuf.activeCounts[i]);
+      }
+    }
+    adjointInterface->createAdjointTypeBuffer(h->sendbuf.values, h->sendbuf.getValueSize(vecSize));
+  }
+
+  inline void AMPI_Alltoallw_b_end(AMPI_Alltoallw_AdjointHandle* h, AdjointInterface* adjointInterface) {
+    for(int i = 0; i < h->sendbuf.ranks; ++i) {
+      adjointInterface->updateAdjoints(h->sendbuf.indices[i], h->sendbuf.getValues(i), h->sendbuf.activeCounts[i]);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbuf.values);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbuf.values);
+    h->sendbuf.deleteValueType();
+    h->recvbuf.deleteValueType();
+  }
+
+  /**
+   * @brief Record the AD data of an Alltoallw call.
+   *
+   * Creates the handle if the tape is active and prepares the modified buffers.
+   */
+  inline AMPI_Alltoallw_AdjointHandle* AMPI_Alltoallw_record(ADToolInterface const* adType, AlltoallwArguments& sendArgs,
+                                                             AlltoallwArguments& recvArgs, AMPI_Comm comm) {
+    AMPI_Alltoallw_AdjointHandle* h = nullptr;
+
+    // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+    if(adType->isHandleRequired()) {
+      h = new AMPI_Alltoallw_AdjointHandle();
+    }
+    adType->startAssembly(h);
+    sendArgs.copyIntoModifiedBuffer();
+
+    if(nullptr != h) {
+      // gather the information for the reverse sweep
+      h->adType = adType;
+      h->comm = comm;
+      h->reverseComm = comm;
+      h->sendbuf.init(sendArgs);
+      h->recvbuf.init(recvArgs);
+
+      // the number of send and receive ranks differ for neighborhood collectives
+      for(int i = 0; i < sendArgs.ranks; ++i) {
+        sendArgs.types[i]->getIndices(sendArgs.bufs[i], 0, h->sendbuf.indices[i], 0, sendArgs.counts[i]);
+      }
+
+      for(int i = 0; i < recvArgs.ranks; ++i) {
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvArgs.types[i]->getADTool().createPrimalTypeBuffer(h->recvbuf.oldPrimals[i], h->recvbuf.activeCounts[i]);
+          recvArgs.types[i]->getValues(recvArgs.bufs[i], 0, h->recvbuf.oldPrimals[i], 0, recvArgs.counts[i]);
+        }
+
+        recvArgs.types[i]->createIndices(recvArgs.bufs[i], 0, h->recvbuf.indices[i], 0, recvArgs.counts[i]);
+      }
+    }
+
+    recvArgs.clearIndices();
+
+    return h;
+  }
+
+  /**
+   * @brief Register the received values of an Alltoallw call and finish the recording.
+   */
+  inline void AMPI_Alltoallw_finishRecord(ADToolInterface const* adType, AMPI_Alltoallw_AdjointHandle* h,
+                                          AlltoallwArguments& recvArgs) {
+    recvArgs.copyFromModifiedBuffer();
+
+    if(nullptr != h) {
+      // handle the recv buffers
+      for(int i = 0; i < recvArgs.ranks; ++i) {
+        recvArgs.types[i]->registerValue(recvArgs.bufs[i], 0, h->recvbuf.indices[i], h->recvbuf.oldPrimals[i],
+                                         0, recvArgs.counts[i]);
+      }
+    }
+
+    adType->stopAssembly(h);
+  }
+
+#if MEDI_MPI_VERSION_2_0 <= MEDI_MPI_TARGET
+  inline void AMPI_Alltoallw_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_p_start(h, adjointInterface);
+    MPI_Alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                  h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                  h->comm);
+    AMPI_Alltoallw_p_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Alltoallw_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_d_start(h, adjointInterface);
+    MPI_Alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                  h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                  h->comm);
+    AMPI_Alltoallw_d_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Alltoallw_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_b_start(h, adjointInterface);
+    MPI_Alltoallv(h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                  h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                  h->comm);
+    AMPI_Alltoallw_b_end(h, adjointInterface);
+  }
+
+  inline int AMPI_Alltoallw(MEDI_OPTIONAL_CONST void* sendbuf, MEDI_OPTIONAL_CONST int* sendcounts,
+                            MEDI_OPTIONAL_CONST int* sdispls, MEDI_OPTIONAL_CONST AMPI_Datatype* sendtypes, void* recvbuf,
+                            MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls,
+                            MEDI_OPTIONAL_CONST AMPI_Datatype* recvtypes, AMPI_Comm comm) {
+    int rStatus;
+    int ranks = getCommSize(comm);
+    ADToolInterface const* adType = selectADTool(sendtypes, recvtypes, ranks);
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      MPI_Datatype* sendMpiTypes = new MPI_Datatype[ranks];
+      MPI_Datatype* recvMpiTypes = new MPI_Datatype[ranks];
+      for(int i = 0; i < ranks; ++i) {
+        sendMpiTypes[i] = sendtypes[i]->getMpiType();
+        recvMpiTypes[i] = recvtypes[i]->getMpiType();
+      }
+
+      rStatus = MPI_Alltoallw(sendbuf, sendcounts, sdispls, sendMpiTypes, recvbuf, recvcounts, rdispls, recvMpiTypes, comm);
+
+      delete [] sendMpiTypes;
+      delete [] recvMpiTypes;
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AlltoallwArguments sendArgs(ranks, sendbuf, sendcounts, sdispls, sendtypes);
+      AlltoallwArguments recvArgs(ranks, recvbuf, recvcounts, rdispls, recvtypes);
+
+      AMPI_Alltoallw_AdjointHandle* h = AMPI_Alltoallw_record(adType, sendArgs, recvArgs, comm);
+      if(nullptr != h) {
+        h->funcReverse = AMPI_Alltoallw_b;
+        h->funcForward = AMPI_Alltoallw_d;
+        h->funcPrimal = AMPI_Alltoallw_p;
+      }
+
+      rStatus = MPI_Alltoallw(sendArgs.mpiBuf, sendArgs.mpiCounts, sendArgs.mpiDispls, sendArgs.mpiTypes,
+                              recvArgs.mpiBuf, recvArgs.mpiCounts, recvArgs.mpiDispls, recvArgs.mpiTypes, comm);
+      adType->addToolAction(h);
+
+      AMPI_Alltoallw_finishRecord(adType, h, recvArgs);
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  inline void AMPI_Ialltoallw_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_p_start(h, adjointInterface);
+    MPI_Ialltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                   h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                   h->comm, &h->requestReverse.request);
+  }
+
+  inline void AMPI_Ialltoallw_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    AMPI_Alltoallw_p_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Ialltoallw_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_d_start(h, adjointInterface);
+    MPI_Ialltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                   h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                   h->comm, &h->requestReverse.request);
+  }
+
+  inline void AMPI_Ialltoallw_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    AMPI_Alltoallw_d_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Ialltoallw_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_b_start(h, adjointInterface);
+    MPI_Ialltoallv(h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls, h->recvbuf.valueType->type,
+                   h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls, h->sendbuf.valueType->type,
+                   h->comm, &h->requestReverse.request);
+  }
+
+  inline void AMPI_Ialltoallw_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    AMPI_Alltoallw_b_end(h, adjointInterface);
+  }
+
+  inline int AMPI_Ialltoallw_finish(HandleBase* handle) {
+    AMPI_Ialltoallw_AsyncHandle* asyncHandle = static_cast<AMPI_Ialltoallw_AsyncHandle*>(handle);
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(asyncHandle->toolHandle);
+
+    if(nullptr != asyncHandle->passiveTypes) {
+      delete [] asyncHandle->passiveTypes;
+    } else {
+      ADToolInterface const* adType = selectADTool(asyncHandle->sendArgs->types, asyncHandle->sendArgs->ranks,
+                                                   asyncHandle->recvArgs->types, asyncHandle->recvArgs->ranks);
+
+      adType->addToolAction(h);
+
+      AMPI_Alltoallw_finishRecord(adType, h, *asyncHandle->recvArgs);
+
+      delete asyncHandle->sendArgs;
+      delete asyncHandle->recvArgs;
+
+      // handle is deleted by the AD tool
+    }
+
+    delete asyncHandle;
+
+    return 0;
+  }
+
+  inline int AMPI_Ialltoallw(const void* sendbuf, const int* sendcounts, const int* sdispls, const AMPI_Datatype* sendtypes,
+                             void* recvbuf, const int* recvcounts, const int* rdispls, const AMPI_Datatype* recvtypes,
+                             AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+    int ranks = getCommSize(comm);
+    ADToolInterface const* adType = selectADTool(sendtypes, recvtypes, ranks);
+
+    AMPI_Ialltoallw_AsyncHandle* asyncHandle = new AMPI_Ialltoallw_AsyncHandle();
+    asyncHandle->sendArgs = nullptr;
+    asyncHandle->recvArgs = nullptr;
+    asyncHandle->passiveTypes = nullptr;
+    asyncHandle->toolHandle = nullptr;
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active, the type arrays need to persist until the request is
+      // finished
+      asyncHandle->passiveTypes = new MPI_Datatype[2 * ranks];
+      MPI_Datatype* sendMpiTypes = asyncHandle->passiveTypes;
+      MPI_Datatype* recvMpiTypes = &asyncHandle->passiveTypes[ranks];
+      for(int i = 0; i < ranks; ++i) {
+        sendMpiTypes[i] = sendtypes[i]->getMpiType();
+        recvMpiTypes[i] = recvtypes[i]->getMpiType();
+      }
+
+      rStatus = MPI_Ialltoallw(sendbuf, sendcounts, sdispls, sendMpiTypes, recvbuf, recvcounts, rdispls, recvMpiTypes,
+                               comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      asyncHandle->sendArgs = new AlltoallwArguments(ranks, sendbuf, sendcounts, sdispls, sendtypes);
+      asyncHandle->recvArgs = new AlltoallwArguments(ranks, recvbuf, recvcounts, rdispls, recvtypes);
+      AlltoallwArguments& sendArgs = *asyncHandle->sendArgs;
+      AlltoallwArguments& recvArgs = *asyncHandle->recvArgs;
+
+      AMPI_Alltoallw_AdjointHandle* h = AMPI_Alltoallw_record(adType, sendArgs, recvArgs, comm);
+      if(nullptr != h) {
+        h->funcReverse = AMPI_Ialltoallw_b;
+        h->funcForward = AMPI_Ialltoallw_d_finish;
+        h->funcPrimal = AMPI_Ialltoallw_p_finish;
+      }
+
+      rStatus = MPI_Ialltoallw(sendArgs.mpiBuf, sendArgs.mpiCounts, sendArgs.mpiDispls, sendArgs.mpiTypes,
+                               recvArgs.mpiBuf, recvArgs.mpiCounts, recvArgs.mpiDispls, recvArgs.mpiTypes, comm,
+                               &request->request);
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ialltoallw_b_finish,
+                                           (ForwardFunction)AMPI_Ialltoallw_d, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    request->handle = asyncHandle;
+    request->func = (ContinueFunction)AMPI_Ialltoallw_finish;
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  /*
+   * Neighbor_alltoallw uses the Alltoallw data structures with one entry per destination neighbor on the send side
+   * and one entry per source neighbor on the receive side. The reverse is a Neighbor_alltoallv of the linear adjoint
+   * buffers on the communicator with the transposed topology, see getTransposedNeighborComm. The communicator is
+   * created during the recording, where all ranks take part. The neighbors that are MPI_PROC_NULL have no AD data.
+   */
+
+  inline void AMPI_Neighbor_alltoallw_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_p_start(h, adjointInterface);
+    MPI_Neighbor_alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls,
+                           h->sendbuf.valueType->type, h->recvbuf.values, h->recvbuf.activeCounts,
+                           h->recvbuf.activeDispls, h->recvbuf.valueType->type, h->comm);
+    AMPI_Alltoallw_p_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Neighbor_alltoallw_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_d_start(h, adjointInterface);
+    MPI_Neighbor_alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls,
+                           h->sendbuf.valueType->type, h->recvbuf.values, h->recvbuf.activeCounts,
+                           h->recvbuf.activeDispls, h->recvbuf.valueType->type, h->comm);
+    AMPI_Alltoallw_d_end(h, adjointInterface);
+  }
+
+  inline void AMPI_Neighbor_alltoallw_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_b_start(h, adjointInterface);
+    MPI_Neighbor_alltoallv(h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls,
+                           h->recvbuf.valueType->type, h->sendbuf.values, h->sendbuf.activeCounts,
+                           h->sendbuf.activeDispls, h->sendbuf.valueType->type, h->reverseComm);
+    AMPI_Alltoallw_b_end(h, adjointInterface);
+  }
+
+  inline int AMPI_Neighbor_alltoallw(MEDI_OPTIONAL_CONST void* sendbuf, MEDI_OPTIONAL_CONST int* sendcounts,
+                                     MEDI_OPTIONAL_CONST MPI_Aint* sdispls, MEDI_OPTIONAL_CONST AMPI_Datatype* sendtypes,
+                                     void* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts,
+                                     MEDI_OPTIONAL_CONST MPI_Aint* rdispls, MEDI_OPTIONAL_CONST AMPI_Datatype* recvtypes,
+                                     AMPI_Comm comm) {
+    int rStatus;
+    int sendRanks = getCommOutDegree(comm);
+    int recvRanks = getCommInDegree(comm);
+    ADToolInterface const* adType = selectADTool(sendtypes, sendRanks, recvtypes, recvRanks);
+
+    if(nullptr == adType || !adType->isActiveType()) {
+      // call the regular function if the type is not active
+      MPI_Datatype* sendMpiTypes = new MPI_Datatype[sendRanks];
+      MPI_Datatype* recvMpiTypes = new MPI_Datatype[recvRanks];
+      for(int i = 0; i < sendRanks; ++i) {
+        sendMpiTypes[i] = sendtypes[i]->getMpiType();
+      }
+      for(int i = 0; i < recvRanks; ++i) {
+        recvMpiTypes[i] = recvtypes[i]->getMpiType();
+      }
+
+      rStatus = MPI_Neighbor_alltoallw(sendbuf, sendcounts, sdispls, sendMpiTypes, recvbuf, recvcounts, rdispls,
+                                       recvMpiTypes, comm);
+
+      delete [] sendMpiTypes;
+      delete [] recvMpiTypes;
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AlltoallwArguments sendArgs(sendRanks, sendbuf, sendcounts, sdispls, sendtypes, comm);
+      AlltoallwArguments recvArgs(recvRanks, recvbuf, recvcounts, rdispls, recvtypes, comm);
+
+      AMPI_Alltoallw_AdjointHandle* h = AMPI_Alltoallw_record(adType, sendArgs, recvArgs, comm);
+      if(nullptr != h) {
+        h->reverseComm = getTransposedNeighborComm(comm);
+        h->funcReverse = AMPI_Neighbor_alltoallw_b;
+        h->funcForward = AMPI_Neighbor_alltoallw_d;
+        h->funcPrimal = AMPI_Neighbor_alltoallw_p;
+      }
+
+      rStatus = MPI_Neighbor_alltoallw(sendArgs.mpiBuf, sendArgs.mpiCounts, sendArgs.mpiByteDispls, sendArgs.mpiTypes,
+                                       recvArgs.mpiBuf, recvArgs.mpiCounts, recvArgs.mpiByteDispls, recvArgs.mpiTypes,
+                                       comm);
+      adType->addToolAction(h);
+
+      AMPI_Alltoallw_finishRecord(adType, h, recvArgs);
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+  inline void AMPI_Ineighbor_alltoallw_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_p_start(h, adjointInterface);
+    MPI_Ineighbor_alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls,
+                            h->sendbuf.valueType->type, h->recvbuf.values, h->recvbuf.activeCounts,
+                            h->recvbuf.activeDispls, h->recvbuf.valueType->type, h->comm, &h->requestReverse.request);
+  }
+
+  inline void AMPI_Ineighbor_alltoallw_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_d_start(h, adjointInterface);
+    MPI_Ineighbor_alltoallv(h->sendbuf.values, h->sendbuf.activeCounts, h->sendbuf.activeDispls,
+                            h->sendbuf.valueType->type, h->recvbuf.values, h->recvbuf.activeCounts,
+                            h->recvbuf.activeDispls, h->recvbuf.valueType->type, h->comm, &h->requestReverse.request);
+  }
+
+  inline void AMPI_Ineighbor_alltoallw_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallw_AdjointHandle* h = static_cast<AMPI_Alltoallw_AdjointHandle*>(handle);
+
+    AMPI_Alltoallw_b_start(h, adjointInterface);
+    MPI_Ineighbor_alltoallv(h->recvbuf.values, h->recvbuf.activeCounts, h->recvbuf.activeDispls,
+                            h->recvbuf.valueType->type, h->sendbuf.values, h->sendbuf.activeCounts,
+                            h->sendbuf.activeDispls, h->sendbuf.valueType->type, h->reverseComm,
+                            &h->requestReverse.request);
+  }
+
+  inline int AMPI_Ineighbor_alltoallw(const void* sendbuf, const int* sendcounts, const MPI_Aint* sdispls,
+                                      const AMPI_Datatype* sendtypes, void* recvbuf, const int* recvcounts,
+                                      const MPI_Aint* rdispls, const AMPI_Datatype* recvtypes, AMPI_Comm comm,
+                                      AMPI_Request* request) {
+    int rStatus;
+    int sendRanks = getCommOutDegree(comm);
+    int recvRanks = getCommInDegree(comm);
+    ADToolInterface const* adType = selectADTool(sendtypes, sendRanks, recvtypes, recvRanks);
+
+    AMPI_Ialltoallw_AsyncHandle* asyncHandle = new AMPI_Ialltoallw_AsyncHandle();
+    asyncHandle->sendArgs = nullptr;
+    asyncHandle->recvArgs = nullptr;
+    asyncHandle->passiveTypes = nullptr;
+    asyncHandle->toolHandle = nullptr;
+
+    if(nullptr == adType || !adType->isActiveType()) {
+      // call the regular function if the type is not active, the type arrays need to persist until the request is
+      // finished
+      asyncHandle->passiveTypes = new MPI_Datatype[sendRanks + recvRanks];
+      MPI_Datatype* sendMpiTypes = asyncHandle->passiveTypes;
+      MPI_Datatype* recvMpiTypes = &asyncHandle->passiveTypes[sendRanks];
+      for(int i = 0; i < sendRanks; ++i) {
+        sendMpiTypes[i] = sendtypes[i]->getMpiType();
+      }
+      for(int i = 0; i < recvRanks; ++i) {
+        recvMpiTypes[i] = recvtypes[i]->getMpiType();
+      }
+
+      rStatus = MPI_Ineighbor_alltoallw(sendbuf, sendcounts, sdispls, sendMpiTypes, recvbuf, recvcounts, rdispls,
+                                        recvMpiTypes, comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      asyncHandle->sendArgs = new AlltoallwArguments(sendRanks, sendbuf, sendcounts, sdispls, sendtypes, comm);
+      asyncHandle->recvArgs = new AlltoallwArguments(recvRanks, recvbuf, recvcounts, rdispls, recvtypes, comm);
+      AlltoallwArguments& sendArgs = *asyncHandle->sendArgs;
+      AlltoallwArguments& recvArgs = *asyncHandle->recvArgs;
+
+      AMPI_Alltoallw_AdjointHandle* h = AMPI_Alltoallw_record(adType, sendArgs, recvArgs, comm);
+      if(nullptr != h) {
+        h->reverseComm = getTransposedNeighborComm(comm);
+        h->funcReverse = AMPI_Ineighbor_alltoallw_b;
+        h->funcForward = AMPI_Ialltoallw_d_finish;
+        h->funcPrimal = AMPI_Ialltoallw_p_finish;
+      }
+
+      rStatus = MPI_Ineighbor_alltoallw(sendArgs.mpiBuf, sendArgs.mpiCounts, sendArgs.mpiByteDispls, sendArgs.mpiTypes,
+                                        recvArgs.mpiBuf, recvArgs.mpiCounts, recvArgs.mpiByteDispls, recvArgs.mpiTypes,
+                                        comm, &request->request);
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ialltoallw_b_finish,
+                                           (ForwardFunction)AMPI_Ineighbor_alltoallw_d, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    request->handle = asyncHandle;
+    request->func = (ContinueFunction)AMPI_Ialltoallw_finish;
+
+    return rStatus;
+  }
+#endif
+}
@@ -29,11 +29,28 @@
 #pragma once
 
 
+#include "adjointTransport.hpp"
+#include "alltoallw.hpp"
 #include "ampiMisc.h"
 #include "async.hpp"
+#include "chunkedReverse.hpp"
+#include "coalescing.hpp"
 #include "constructedDatatypes.hpp"
+#include "deferredReverse.hpp"
 #include "enums.hpp"
+#include "hierarchicalReverse.hpp"
 #include "operatorFunctions.hpp"
+#include "parallelElements.hpp"
+#include "partitioned.hpp"
+#include "persistentCollectives.hpp"
+#include "progressThread.hpp"
+#include "requestTable.hpp"
+#include "reverseBatch.hpp"
+#include "reversePrefetch.hpp"
+#include "reverseSendWindow.hpp"
+#include "sendrecvReplace.hpp"
+#include "shadowComm.hpp"
+#include "sparseEncoding.hpp"
 #include "typeInterface.hpp"
 #include "typeDefault.hpp"
 #include "wrappers.hpp"
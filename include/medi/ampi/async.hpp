@@ -57,6 +57,10 @@ namespace medi {
       void* reverseData;
       DeleteReverseData deleteDataFunc;
 
+      // required for reverse communication that needs to process its buffers after the completion
+      void* completionData;
+      DeleteReverseData completionFunc;
+
       AMPI_Request() :
         request(MPI_REQUEST_NULL),
         handle(NULL),
@@ -65,7 +69,9 @@ namespace medi {
         end(NULL),
         isActive(false),
         reverseData(NULL),
-        deleteDataFunc(NULL){}
+        deleteDataFunc(NULL),
+        completionData(NULL),
+        completionFunc(NULL){}
 
       inline void setReverseData(void* data, DeleteReverseData func) {
         this->reverseData = data;
@@ -75,6 +81,19 @@ namespace medi {
       inline void deleteReverseData() {
         if(NULL != reverseData) {
            this->deleteDataFunc(this->reverseData);
+           this->reverseData = NULL;
+        }
+      }
+
+      inline void setCompletionData(void* data, DeleteReverseData func) {
+        this->completionData = data;
+        this->completionFunc = func;
+      }
+
+      inline void performCompletionAction() {
+        if(NULL != completionData) {
+          this->completionFunc(this->completionData);
+          this->completionData = NULL;
         }
       }
   };
@@ -164,6 +183,16 @@ namespace medi {
     }
   }
 
+  /**
+   * @brief Copy the MPI requests out of an array of AMPI_Request.
+   *
+   * AMPI_Request stores the MeDiPack data next to the MPI request, therefore the user arrays can not be given directly
+   * to MPI. The caller deletes the returned array.
+   *
+   * @param[in] array  The requests of the user.
+   * @param[in] count  The number of requests.
+   * @return A new array with the MPI requests.
+   */
   inline MPI_Request* convertToMPI(AMPI_Request* array, int count) {
     MPI_Request* converted = new MPI_Request[count];
 
@@ -291,17 +320,75 @@ namespace medi {
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  /**
+   * @brief Wait for all requests and perform the reverse actions as soon as the requests complete.
+   *
+   * The requests are completed with MPI_Waitsome. The reverse actions, e.g. the copy from the modified buffers and the
+   * registration of the received values, are performed while the other messages are still in transit. The reverse
+   * actions record the handles on the tape, therefore they are performed in the order of the requests: A request is
+   * only finished after all requests before it have been finished. Otherwise messages with the same peer, tag and
+   * communicator could be matched in a different order in the reverse evaluation. The statuses are sorted into the
+   * positions of their requests. Null and inactive requests get an empty status, as in MPI_Waitall.
+   */
   inline int AMPI_Waitall(int count, AMPI_Request* array_of_requests, AMPI_Status* array_of_statuses) {
     MPI_Request* array = convertToMPI(array_of_requests, count);
+    int* indices = new int[count];
+    bool* completed = new bool[count];
+    MPI_Status* statuses = MPI_STATUSES_IGNORE;
+    if(MPI_STATUSES_IGNORE != array_of_statuses) {
+      statuses = new MPI_Status[count];
 
-    int rStatus = MPI_Waitall(count, array, array_of_statuses);
+      for(int i = 0; i < count; ++i) {
+        MPI_Request nullRequest = MPI_REQUEST_NULL;
+        MPI_Wait(&nullRequest, &array_of_statuses[i]);
+      }
+    }
 
     for(int i = 0; i < count; ++i) {
-      if(AMPI_REQUEST_NULL != array_of_requests[i]) {
-        performReverseAction(&array_of_requests[i]);
+      // Null and inactive persistent requests are never reported by MPI_Waitsome.
+      completed[i] = MPI_REQUEST_NULL == array[i]
+                     || (nullptr != array_of_requests[i].start && !array_of_requests[i].isActive);
+    }
+
+    int rStatus = MPI_SUCCESS;
+    int outcount = 0;
+    int next = 0; // First request that is not yet finished.
+    while(MPI_SUCCESS == rStatus) {
+      rStatus = MPI_Waitsome(count, array, &outcount, indices, statuses);
+      if(MPI_UNDEFINED == outcount) {
+        break;
+      }
+
+      for(int i = 0; i < outcount; ++i) {
+        int index = indices[i];
+        if(MPI_STATUSES_IGNORE != array_of_statuses) {
+          array_of_statuses[index] = statuses[i];
+        }
+        completed[index] = true;
+      }
+
+      // Finish the leading run of completed requests.
+      while(next < count && completed[next]) {
+        if(AMPI_REQUEST_NULL != array_of_requests[next]) {
+          performReverseAction(&array_of_requests[next]);
+        }
+        next += 1;
       }
     }
 
+    if(MPI_SUCCESS == rStatus) {
+      for(; next < count; ++next) {
+        if(AMPI_REQUEST_NULL != array_of_requests[next]) {
+          performReverseAction(&array_of_requests[next]);
+        }
+      }
+    }
+
+    if(MPI_STATUSES_IGNORE != array_of_statuses) {
+      delete [] statuses;
+    }
+    delete [] completed;
+    delete [] indices;
     delete [] array;
 
     return rStatus;
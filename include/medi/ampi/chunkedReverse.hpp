@@ -0,0 +1,428 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "adjointTransport.hpp"
+#include "async.hpp"
+#include "coalescing.hpp"
+#include "shadowComm.hpp"
+#include "../adjointInterface.hpp"
+#include "../macros.h"
+#include "../mpiTools.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the chunk size for large adjoint messages of the point-to-point operations.
+   *
+   * Adjoint messages of the blocking send and receive operations with more adjoint values than the chunk size are
+   * split into messages of at most this size. A value of zero disables the chunking.
+   *
+   * The reverse of Send and Recv pipelines the chunks. The adjoints of a chunk are extracted while the previous one is
+   * sent, and received chunks are applied while later ones arrive. At most two chunks are buffered on each side. The
+   * other operations exchange the chunks without the overlap with the AD tool.
+   *
+   * Chunks are always exchanged with the standard send mode. The value needs to be the same on all ranks during the
+   * reverse evaluation.
+   *
+   * @return Reference to the chunk size, in values of the adjoint MPI type.
+   */
+  inline LargeCount& reverseChunkSize() {
+    static LargeCount size = 0;
+
+    return size;
+  }
+
+  /**
+   * @brief Set the chunk size for large adjoint messages of the point-to-point operations.
+   * @param[in] size  The maximum number of adjoint values in one message, zero disables the chunking.
+   */
+  inline void setReverseChunkSize(LargeCount size) {
+    reverseChunkSize() = size;
+  }
+
+  /**
+   * @brief Check if an adjoint message is split into chunks.
+   * @param[in] elements  The number of adjoint values in the message.
+   * @return True if the message is larger than the chunk size.
+   */
+  inline bool isReverseChunked(LargeCount elements) {
+    return 0 < reverseChunkSize() && elements > reverseChunkSize();
+  }
+
+  /**
+   * @brief The chunks of adjoint point-to-point messages.
+   *
+   * All chunks are posted at once and completed in wait. The chunks of one message have the same tag, the MPI ordering
+   * guarantees that they match in order. Every chunk is converted with its own AdjointTransport.
+   */
+  struct ChunkedAdjointMessages {
+    private:
+      std::vector<MPI_Request> requests;
+      std::vector<AdjointTransport*> transports;
+
+    public:
+
+      ChunkedAdjointMessages() = default;
+
+      ~ChunkedAdjointMessages() {
+        wait();
+      }
+
+      /**
+       * @brief Post the sends for the chunks of a buffer.
+       *
+       * @param[in,out]       buf  The adjoint buffer.
+       * @param[in]      elements  The number of adjoint values in the buffer.
+       * @param[in]   adjointType  The adjoint MPI type of the AD tool.
+       * @param[in]          dest  The destination rank.
+       * @param[in]           tag  The tag of the message.
+       * @param[in]          comm  The user communicator.
+       */
+      void send(void* buf, LargeCount elements, MPI_Datatype adjointType, int dest, int tag, MPI_Comm comm) {
+        post(true, buf, elements, adjointType, dest, tag, comm);
+      }
+
+      /**
+       * @brief Post the receives for the chunks of a buffer.
+       *
+       * @param[out]          buf  The adjoint buffer.
+       * @param[in]      elements  The number of adjoint values in the buffer.
+       * @param[in]   adjointType  The adjoint MPI type of the AD tool.
+       * @param[in]           src  The source rank.
+       * @param[in]           tag  The tag of the message.
+       * @param[in]          comm  The user communicator.
+       */
+      void recv(void* buf, LargeCount elements, MPI_Datatype adjointType, int src, int tag, MPI_Comm comm) {
+        post(false, buf, elements, adjointType, src, tag, comm);
+      }
+
+      /**
+       * @brief Complete all posted chunks and convert the buffers back.
+       */
+      void wait() {
+        if(!requests.empty()) {
+          MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+          requests.clear();
+        }
+
+        for(AdjointTransport* transport : transports) {
+          transport->finish();
+          delete transport;
+        }
+        transports.clear();
+      }
+
+      /**
+       * @brief Complete the chunks when the request is completed in the reverse evaluation.
+       *
+       * The object needs to be created with new, it is deleted in the completion action of the request.
+       *
+       * @param[in,out] request  The request of the non-blocking reverse communication.
+       */
+      void finish(AMPI_Request* request) {
+        request->request = MPI_REQUEST_NULL;
+        request->setCompletionData(reinterpret_cast<void*>(this), ChunkedAdjointMessages::finishFunc);
+      }
+
+      /**
+       * @brief Completion function for requests, see finish(AMPI_Request*).
+       */
+      static void finishFunc(void* data) {
+        delete reinterpret_cast<ChunkedAdjointMessages*>(data);
+      }
+
+    private:
+
+      ChunkedAdjointMessages(const ChunkedAdjointMessages&) = delete;
+      ChunkedAdjointMessages& operator=(const ChunkedAdjointMessages&) = delete;
+
+      void post(bool isSend, void* buf, LargeCount elements, MPI_Datatype adjointType, int rank, int tag,
+                MPI_Comm comm) {
+        MPI_Aint lb;
+        MPI_Aint extent;
+        MPI_Type_get_extent(adjointType, &lb, &extent);
+
+        // At least one message is posted, such that empty messages are matched as well.
+        LargeCount chunk = isReverseChunked(elements) ? reverseChunkSize() : elements;
+
+        LargeCount pos = 0;
+        do {
+          LargeCount size = std::min(chunk, elements - pos);
+          void* chunkBuf = reinterpret_cast<char*>(buf) + pos * extent;
+
+          AdjointTransport* transport = new AdjointTransport(comm, adjointType);
+          transports.push_back(transport);
+          requests.push_back(MPI_REQUEST_NULL);
+
+          if(isSend) {
+            AdjointMessage message = transport->sendMessage(chunkBuf, size, adjointType);
+            LargeCountType type(message.count, message.type);
+            MPI_Isend(message.buf, type.count, type.type, rank, tag, getShadowComm(comm), &requests.back());
+          } else {
+            AdjointMessage message = transport->recvMessage(chunkBuf, size, adjointType);
+            LargeCountType type(message.count, message.type);
+            MPI_Irecv(message.buf, type.count, type.type, rank, tag, getShadowComm(comm), &requests.back());
+          }
+
+          pos += size;
+        } while(pos < elements);
+      }
+  };
+
+  /**
+   * @brief Replace the adjoint buffer with the chunks from the source and send the chunks of the buffer to the
+   * destination.
+   *
+   * The buffer is exchanged chunk by chunk. Each received chunk is stored in a temporary buffer of one chunk until
+   * the chunk at the same position has been sent.
+   *
+   * @param[in,out]         buf  The adjoint buffer.
+   * @param[in]        elements  The number of adjoint values in the buffer.
+   * @param[in]     adjointType  The adjoint MPI type of the AD tool.
+   * @param[in]            dest  The destination rank.
+   * @param[in]         sendtag  The tag of the sent message.
+   * @param[in]          source  The source rank.
+   * @param[in]         recvtag  The tag of the received message.
+   * @param[in]            comm  The user communicator.
+   */
+  inline void chunkedSendrecvReplace(void* buf, LargeCount elements, MPI_Datatype adjointType, int dest, int sendtag,
+                                     int source, int recvtag, MPI_Comm comm) {
+    MPI_Aint lb;
+    MPI_Aint extent;
+    MPI_Type_get_extent(adjointType, &lb, &extent);
+
+    // At least one chunk is exchanged, such that empty messages are matched as well.
+    LargeCount chunk = isReverseChunked(elements) ? reverseChunkSize() : elements;
+    std::vector<char> received(chunk * extent);
+
+    LargeCount pos = 0;
+    do {
+      LargeCount size = std::min(chunk, elements - pos);
+      void* chunkBuf = reinterpret_cast<char*>(buf) + pos * extent;
+
+      ChunkedAdjointMessages chunks;
+      chunks.recv(received.data(), size, adjointType, source, recvtag, comm);
+      chunks.send(chunkBuf, size, adjointType, dest, sendtag, comm);
+      chunks.wait();
+
+      std::memcpy(chunkBuf, received.data(), size * extent);
+      pos += size;
+    } while(pos < elements);
+  }
+
+  /**
+   * @brief Check if the reverse of a Send or Recv is pipelined, see reverseChunkSize.
+   *
+   * The chunks need to contain whole vectors of the AD tool and the index type needs to be known. The number of
+   * elements in a chunk needs to be in the range of the counts of the AdjointInterface. Otherwise the chunks are
+   * exchanged without the overlap.
+   *
+   * @param[in]              indices  The indices of the active elements.
+   * @param[in]          bufCountVec  The number of adjoint values in the message.
+   * @param[in]         bufTotalSize  The number of active elements in the buffer.
+   * @param[in]                 comm  The user communicator.
+   * @param[in]     adjointInterface  The interface to the AD tool.
+   * @return True if the message is chunked and can be pipelined.
+   */
+  template<typename IndexType>
+  bool isPipelinedReverse(IndexType* indices, LargeCount bufCountVec, LargeCount bufTotalSize, MPI_Comm comm,
+                          AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(indices);
+    LargeCount vectorSize = adjointInterface->getVectorSize();
+
+    return !std::is_void<IndexType>::value
+        && isReverseChunked(bufCountVec)
+        && nullptr == getActiveReverseCoalescingState(comm)
+        && bufCountVec == vectorSize * bufTotalSize
+        && 0 == reverseChunkSize() % vectorSize
+        && reverseChunkSize() / vectorSize <= INT_MAX;
+  }
+
+  /**
+   * @brief Get the indices of the elements starting at a position.
+   *
+   * @param[in] indices  The indices of the active elements.
+   * @param[in]     pos  The position of the first element.
+   * @return The indices from the position on.
+   */
+  template<typename IndexType>
+  IndexType* shiftIndices(IndexType* indices, LargeCount pos) {
+    return indices + pos;
+  }
+
+  /**
+   * @brief Untyped indices can not be shifted, see isPipelinedReverse.
+   */
+  inline void* shiftIndices(void* indices, LargeCount pos) {
+    MEDI_UNUSED(pos);
+    MEDI_EXCEPTION("The indices of untyped datatypes can not be split into chunks.");
+
+    return indices;
+  }
+
+  /**
+   * @brief State of one of the two chunk buffers of a pipelined reverse.
+   */
+  struct PipelinedChunk {
+      void* adjoints;
+      AdjointTransport* transport;
+      MPI_Request request;
+      LargeCount pos;
+      LargeCount size;
+  };
+
+  /**
+   * @brief Pipelined reverse of a blocking Recv, the adjoints are extracted and sent chunk by chunk.
+   *
+   * The chunks fit into the int counts of the AdjointInterface, see isPipelinedReverse.
+   *
+   * @param[in]          indices  The indices of the active elements.
+   * @param[in]     bufTotalSize  The number of active elements.
+   * @param[in]      adjointType  The adjoint MPI type of the AD tool.
+   * @param[in]             dest  The destination rank of the adjoint message.
+   * @param[in]              tag  The tag of the message.
+   * @param[in]             comm  The user communicator.
+   * @param[in] adjointInterface  The interface to the AD tool.
+   */
+  template<typename IndexType>
+  void pipelinedAdjointSend(IndexType* indices, LargeCount bufTotalSize, MPI_Datatype adjointType, int dest, int tag,
+                            MPI_Comm comm, AdjointInterface* adjointInterface) {
+    LargeCount vectorSize = adjointInterface->getVectorSize();
+    LargeCount chunk = reverseChunkSize() / vectorSize;
+
+    PipelinedChunk chunks[2];
+    for(PipelinedChunk& c : chunks) {
+      c.adjoints = nullptr;
+      adjointInterface->createAdjointTypeBuffer(c.adjoints, chunk);
+      c.transport = nullptr;
+      c.request = MPI_REQUEST_NULL;
+    }
+
+    int k = 0;
+    for(LargeCount pos = 0; pos < bufTotalSize; pos += chunk, ++k) {
+      PipelinedChunk& c = chunks[k % 2];
+      if(nullptr != c.transport) {
+        MPI_Wait(&c.request, MPI_STATUS_IGNORE);
+        delete c.transport;
+      }
+
+      // The extraction overlaps with the transfer of the previous chunk.
+      c.size = std::min(chunk, bufTotalSize - pos);
+      adjointInterface->getAdjoints(shiftIndices(indices, pos), c.adjoints, (int)c.size);
+
+      c.transport = new AdjointTransport(comm, adjointType);
+      AdjointMessage message = c.transport->sendMessage(c.adjoints, c.size * vectorSize, adjointType);
+      LargeCountType type(message.count, message.type);
+      MPI_Isend(message.buf, type.count, type.type, dest, tag, getShadowComm(comm), &c.request);
+    }
+
+    for(PipelinedChunk& c : chunks) {
+      if(nullptr != c.transport) {
+        MPI_Wait(&c.request, MPI_STATUS_IGNORE);
+        delete c.transport;
+      }
+      adjointInterface->deleteAdjointTypeBuffer(c.adjoints);
+    }
+  }
+
+  /**
+   * @brief Pipelined reverse of a blocking Send, the adjoints are received and applied chunk by chunk.
+   *
+   * The chunks fit into the int counts of the AdjointInterface, see isPipelinedReverse.
+   *
+   * @param[in]          indices  The indices of the active elements.
+   * @param[in]     bufTotalSize  The number of active elements.
+   * @param[in]      adjointType  The adjoint MPI type of the AD tool.
+   * @param[in]              src  The source rank of the adjoint message.
+   * @param[in]              tag  The tag of the message.
+   * @param[in]             comm  The user communicator.
+   * @param[in] adjointInterface  The interface to the AD tool.
+   */
+  template<typename IndexType>
+  void pipelinedAdjointRecv(IndexType* indices, LargeCount bufTotalSize, MPI_Datatype adjointType, int src, int tag,
+                            MPI_Comm comm, AdjointInterface* adjointInterface) {
+    LargeCount vectorSize = adjointInterface->getVectorSize();
+    LargeCount chunk = reverseChunkSize() / vectorSize;
+
+    PipelinedChunk chunks[2];
+    LargeCount nextPos = 0;
+    for(PipelinedChunk& c : chunks) {
+      c.adjoints = nullptr;
+      adjointInterface->createAdjointTypeBuffer(c.adjoints, chunk);
+      c.transport = nullptr;
+      c.request = MPI_REQUEST_NULL;
+    }
+
+    auto postChunk = [&](PipelinedChunk& c) {
+      c.pos = nextPos;
+      c.size = std::min(chunk, bufTotalSize - nextPos);
+      nextPos += c.size;
+
+      c.transport = new AdjointTransport(comm, adjointType);
+      AdjointMessage message = c.transport->recvMessage(c.adjoints, c.size * vectorSize, adjointType);
+      LargeCountType type(message.count, message.type);
+      MPI_Irecv(message.buf, type.count, type.type, src, tag, getShadowComm(comm), &c.request);
+    };
+
+    for(PipelinedChunk& c : chunks) {
+      if(nextPos < bufTotalSize) {
+        postChunk(c);
+      }
+    }
+
+    for(int k = 0; nullptr != chunks[k % 2].transport; ++k) {
+      PipelinedChunk& c = chunks[k % 2];
+      MPI_Wait(&c.request, MPI_STATUS_IGNORE);
+      c.transport->finish();
+      delete c.transport;
+      c.transport = nullptr;
+
+      // The update overlaps with the transfer of the next chunk.
+      adjointInterface->updateAdjoints(shiftIndices(indices, c.pos), c.adjoints, (int)c.size);
+
+      if(nextPos < bufTotalSize) {
+        postChunk(c);
+      }
+    }
+
+    for(PipelinedChunk& c : chunks) {
+      adjointInterface->deleteAdjointTypeBuffer(c.adjoints);
+    }
+  }
+}
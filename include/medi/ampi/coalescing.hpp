@@ -0,0 +1,350 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "ampiMisc.h"
+#include "async.hpp"
+#include "shadowComm.hpp"
+#include "../adToolInterface.h"
+#include "../exceptions.hpp"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Tag for the batches of coalesced adjoint messages.
+   */
+  const int REVERSE_COALESCING_TAG = 32766;
+
+  /**
+   * @brief One adjoint message that was received as part of a batch.
+   */
+  struct CoalescedMessage {
+      int tag;
+      std::vector<char> data;
+  };
+
+  /**
+   * @brief The adjoint messages of one communicator that are collected in the reverse sweep.
+   *
+   * Outgoing messages are collected per destination rank and sent as one batch when the rank would block otherwise.
+   * A batch consists of the number of messages, the tags, the sizes in bytes and the data of all messages.
+   */
+  struct ReverseCoalescingState {
+      bool active;
+
+      std::map<int, std::vector<int>> outgoingTags;
+      std::map<int, std::vector<int>> outgoingSizes;
+      std::map<int, std::vector<char>> outgoingData;
+      std::map<int, std::deque<CoalescedMessage>> incoming;
+
+      std::list<std::vector<char>> pendingBatches;
+      std::vector<MPI_Request> pendingRequests;
+
+      ReverseCoalescingState() :
+        active(false),
+        outgoingTags(),
+        outgoingSizes(),
+        outgoingData(),
+        incoming(),
+        pendingBatches(),
+        pendingRequests() {}
+
+      /**
+       * @brief Add a message to the batch for the destination rank.
+       */
+      void add(int dest, int tag, const void* buf, int bytes) {
+        std::vector<char>& data = outgoingData[dest];
+        const char* bytePtr = reinterpret_cast<const char*>(buf);
+
+        outgoingTags[dest].push_back(tag);
+        outgoingSizes[dest].push_back(bytes);
+        data.insert(data.end(), bytePtr, bytePtr + bytes);
+      }
+
+      /**
+       * @brief Send all collected batches with nonblocking sends.
+       */
+      void flush(MPI_Comm comm) {
+        for(auto& tags : outgoingTags) {
+          int dest = tags.first;
+          int messages = (int)tags.second.size();
+          if(0 == messages) {
+            continue;
+          }
+
+          std::vector<int>& sizes = outgoingSizes[dest];
+          std::vector<char>& data = outgoingData[dest];
+
+          size_t headerBytes = (1 + 2 * messages) * sizeof(int);
+          pendingBatches.emplace_back(headerBytes + data.size());
+          char* batch = pendingBatches.back().data();
+
+          std::memcpy(batch, &messages, sizeof(int));
+          std::memcpy(batch + sizeof(int), tags.second.data(), messages * sizeof(int));
+          std::memcpy(batch + (1 + messages) * sizeof(int), sizes.data(), messages * sizeof(int));
+          std::memcpy(batch + headerBytes, data.data(), data.size());
+
+          pendingRequests.push_back(MPI_REQUEST_NULL);
+          MPI_Isend(batch, (int)pendingBatches.back().size(), MPI_BYTE, dest, REVERSE_COALESCING_TAG, comm,
+                    &pendingRequests.back());
+
+          tags.second.clear();
+          sizes.clear();
+          data.clear();
+        }
+      }
+
+      /**
+       * @brief Get the next message with the tag from the source rank.
+       *
+       * If no such message was received yet, the own batches are sent and the next batch of the source is received.
+       */
+      void get(int source, int tag, void* buf, int bytes, MPI_Comm comm) {
+        std::deque<CoalescedMessage>& messages = incoming[source];
+
+        while(true) {
+          for(auto iter = messages.begin(); iter != messages.end(); ++iter) {
+            if(iter->tag == tag) {
+              if((int)iter->data.size() != bytes) {
+                MEDI_EXCEPTION("Coalesced message from rank %d with tag %d has %d bytes, expected %d bytes.", source, tag,
+                               (int)iter->data.size(), bytes);
+              }
+
+              std::memcpy(buf, iter->data.data(), bytes);
+              messages.erase(iter);
+
+              return;
+            }
+          }
+
+          // this rank would block, send the own messages first
+          flush(comm);
+
+          MPI_Status status;
+          int batchBytes;
+          MPI_Probe(source, REVERSE_COALESCING_TAG, comm, &status);
+          MPI_Get_count(&status, MPI_BYTE, &batchBytes);
+
+          std::vector<char> batch(batchBytes);
+          MPI_Recv(batch.data(), batchBytes, MPI_BYTE, source, REVERSE_COALESCING_TAG, comm, MPI_STATUS_IGNORE);
+
+          int count;
+          std::memcpy(&count, batch.data(), sizeof(int));
+          const int* tags = reinterpret_cast<const int*>(batch.data() + sizeof(int));
+          const int* sizes = tags + count;
+          const char* data = batch.data() + (1 + 2 * count) * sizeof(int);
+          for(int i = 0; i < count; ++i) {
+            messages.push_back(CoalescedMessage{tags[i], std::vector<char>(data, data + sizes[i])});
+            data += sizes[i];
+          }
+        }
+      }
+
+      /**
+       * @brief Send the remaining batches and wait until all batches are sent.
+       */
+      void finish(MPI_Comm comm) {
+        flush(comm);
+
+        MPI_Waitall((int)pendingRequests.size(), pendingRequests.data(), MPI_STATUSES_IGNORE);
+        pendingRequests.clear();
+        pendingBatches.clear();
+
+        for(auto& messages : incoming) {
+          if(!messages.second.empty()) {
+            MEDI_EXCEPTION("%d coalesced messages from rank %d were not received.", (int)messages.second.size(),
+                           messages.first);
+          }
+        }
+      }
+  };
+
+  /**
+   * @brief Attribute delete function for the coalescing state of a communicator.
+   */
+  inline int deleteReverseCoalescingState(MPI_Comm comm, int keyval, void* attributeVal, void* extraState) {
+    MEDI_UNUSED(comm);
+    MEDI_UNUSED(keyval);
+    MEDI_UNUSED(extraState);
+
+    delete reinterpret_cast<ReverseCoalescingState*>(attributeVal);
+
+    return MPI_SUCCESS;
+  }
+
+  /**
+   * @brief Get the coalescing state of the communicator.
+   *
+   * @param[in]   comm  The communicator.
+   * @param[in] create  Create the state if the communicator has none.
+   * @return The state or nullptr if it does not exist.
+   */
+  inline ReverseCoalescingState* getReverseCoalescingState(MPI_Comm comm, bool create) {
+    static int keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, deleteReverseCoalescingState);
+
+    ReverseCoalescingState* state;
+    int flag;
+    MPI_Comm_get_attr(comm, keyval, &state, &flag);
+    if(!flag) {
+      state = nullptr;
+      if(create) {
+        state = new ReverseCoalescingState();
+        MPI_Comm_set_attr(comm, keyval, state);
+      }
+    }
+
+    return state;
+  }
+
+  /**
+   * @brief Get the coalescing state of the communicator if messages are coalesced at the moment.
+   *
+   * @param[in] comm  The communicator.
+   * @return The state or nullptr if the messages on the communicator are not coalesced.
+   */
+  inline ReverseCoalescingState* getActiveReverseCoalescingState(MPI_Comm comm) {
+    ReverseCoalescingState* state = getReverseCoalescingState(comm, false);
+    if(nullptr != state && !state->active) {
+      state = nullptr;
+    }
+
+    return state;
+  }
+
+  /**
+   * @brief Get the number of bytes of an adjoint buffer.
+   */
+  inline int computeAdjointBytes(LargeCount count, MPI_Datatype type) {
+    MPI_Aint lb;
+    MPI_Aint extent;
+    MPI_Type_get_extent(type, &lb, &extent);
+
+    LargeCount bytes = count * extent;
+    if(bytes > INT_MAX) {
+      MEDI_EXCEPTION("Message with %lld bytes is too large for reverse coalescing.", (long long)bytes);
+    }
+
+    return (int)bytes;
+  }
+
+  struct AMPI_Reverse_coalescing_AdjointHandle : public HandleBase {
+      AMPI_Comm comm;
+  };
+
+  inline void AMPI_Reverse_coalescing_begin_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(adjointInterface);
+    AMPI_Reverse_coalescing_AdjointHandle* h = static_cast<AMPI_Reverse_coalescing_AdjointHandle*>(handle);
+
+    ReverseCoalescingState* state = getReverseCoalescingState(h->comm, true);
+    state->finish(getShadowComm(h->comm));
+    state->active = false;
+  }
+
+  inline void AMPI_Reverse_coalescing_end_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(adjointInterface);
+    AMPI_Reverse_coalescing_AdjointHandle* h = static_cast<AMPI_Reverse_coalescing_AdjointHandle*>(handle);
+
+    getReverseCoalescingState(h->comm, true)->active = true;
+  }
+
+  inline void AMPI_Reverse_coalescing_noop(HandleBase* handle, AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(handle);
+    MEDI_UNUSED(adjointInterface);
+  }
+
+  /**
+   * @brief Record a tool action that changes the coalescing state of the communicator in the reverse sweep.
+   */
+  template<typename DATATYPE>
+  inline void recordReverseCoalescing(DATATYPE* datatype, AMPI_Comm comm, ReverseFunction reverse) {
+    ADToolInterface const& adType = datatype->getADTool();
+    AMPI_Reverse_coalescing_AdjointHandle* h = nullptr;
+
+    if(adType.isHandleRequired()) {
+      h = new AMPI_Reverse_coalescing_AdjointHandle();
+      h->funcReverse = reverse;
+      h->funcForward = AMPI_Reverse_coalescing_noop;
+      h->funcPrimal = AMPI_Reverse_coalescing_noop;
+      h->comm = comm;
+    }
+
+    adType.startAssembly(h);
+    adType.addToolAction(h);
+    adType.stopAssembly(h);
+  }
+
+  /**
+   * @brief Start a region in which the adjoint point-to-point messages on the communicator are coalesced.
+   *
+   * In the reverse sweep, the adjoint messages of blocking receives and nonblocking receives in the region are not
+   * sent directly. They are collected per destination rank and sent as one message when the rank would block for an
+   * adjoint message, or at the start of the region. The reverse of blocking sends takes the adjoint messages from these
+   * batches.
+   *
+   * The region needs to be recorded on all ranks of the communicator. Nonblocking sends and collective communication
+   * are not allowed on the communicator in the region.
+   *
+   * @param[in] datatype  A type of the AD tool for which the region is recorded.
+   * @param[in]     comm  The communicator of the point-to-point messages.
+   */
+  template<typename DATATYPE>
+  inline int AMPI_Reverse_coalescing_begin(DATATYPE* datatype, AMPI_Comm comm) {
+    recordReverseCoalescing(datatype, comm, AMPI_Reverse_coalescing_begin_b);
+
+    return MPI_SUCCESS;
+  }
+
+  /**
+   * @brief End a region in which the adjoint point-to-point messages on the communicator are coalesced.
+   *
+   * See AMPI_Reverse_coalescing_begin for details.
+   *
+   * @param[in] datatype  A type of the AD tool for which the region is recorded.
+   * @param[in]     comm  The communicator of the point-to-point messages.
+   */
+  template<typename DATATYPE>
+  inline int AMPI_Reverse_coalescing_end(DATATYPE* datatype, AMPI_Comm comm) {
+    recordReverseCoalescing(datatype, comm, AMPI_Reverse_coalescing_end_b);
+
+    return MPI_SUCCESS;
+  }
+}
@@ -31,6 +31,7 @@
 #include <cstdlib>
 
 #include "../macros.h"
+#include "parallelElements.hpp"
 #include "typeInterface.hpp"
 #include "../exceptions.hpp"
 
@@ -303,12 +304,12 @@ namespace medi {
         delete [] types;
       }
 
-      int computeBufOffset(size_t element) const {
-        return (int)(element * typeExtent);
+      size_t computeBufOffset(size_t element) const {
+        return element * typeExtent;
       }
 
-      int computeModOffset(size_t element) const {
-        return (int)(element * modifiedExtent);
+      size_t computeModOffset(size_t element) const {
+        return element * modifiedExtent;
       }
 
       const void* computeBufferPointer(const void* buf, size_t offset) const {
@@ -333,57 +334,61 @@ namespace medi {
       }
 
       void copyIntoModifiedBuffer(const void* buf, size_t bufOffset, void* bufMod, size_t bufModOffset, int elements) const {
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
-          int totalModOffset = computeModOffset(i + bufModOffset);
+        forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalModOffset = computeModOffset(i + bufModOffset);
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->copyIntoModifiedBuffer(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, computeBufferPointer(bufMod, totalModOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
           }
-        }
+        });
       }
 
       void copyFromModifiedBuffer(void* buf, size_t bufOffset, const void* bufMod, size_t bufModOffset, int elements) const {
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
-          int totalModOffset = computeModOffset(i + bufModOffset);
+        forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalModOffset = computeModOffset(i + bufModOffset);
 
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->copyFromModifiedBuffer(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, computeBufferPointer(bufMod, totalModOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
           }
-        }
+        });
       }
 
       void getIndices(const void* buf, size_t bufOffset, void* indices, size_t bufModOffset, int elements) const {
-        int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
-
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+        forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalIndexOffset = (bufModOffset + i) * valuesPerElement;  // indices are lineralized per element
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->getIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, totalIndexOffset, blockLengths[curType]);
             totalIndexOffset += types[curType]->computeActiveElements(blockLengths[curType]);
           }
-        }
+        });
       }
 
       void registerValue(void* buf, size_t bufOffset, void* indices, void* oldPrimals, size_t bufModOffset, int elements) const {
-        int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
-
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+        bool parallel = !parallelIndexCreation().active &&
+                        beginParallelIndices(*adInterface, elements, computeActiveElements(elements),
+                                             bufModOffset * valuesPerElement);
+        forEachElement(elements, parallel, [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalIndexOffset = (bufModOffset + i) * valuesPerElement;  // indices are lineralized per element
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->registerValue(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, oldPrimals, totalIndexOffset, blockLengths[curType]);
             totalIndexOffset +=  types[curType]->computeActiveElements(blockLengths[curType]);
           }
+        });
+        if(parallel) {
+          endParallelIndices(*adInterface);
         }
       }
 
       void clearIndices(void* buf, size_t bufOffset, int elements) const {
         for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->clearIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
@@ -392,33 +397,38 @@ namespace medi {
       }
 
       void createIndices(void* buf, size_t bufOffset, void* indices, size_t bufModOffset, int elements) const {
-        int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
-
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+        bool parallel = !parallelIndexCreation().active &&
+                        beginParallelIndices(*adInterface, elements, computeActiveElements(elements),
+                                             bufModOffset * valuesPerElement);
+        forEachElement(elements, parallel, [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalIndexOffset = (bufModOffset + i) * valuesPerElement;  // indices are lineralized per element
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->createIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, totalIndexOffset, blockLengths[curType]);
             totalIndexOffset +=  types[curType]->computeActiveElements(blockLengths[curType]);
           }
+        });
+        if(parallel) {
+          endParallelIndices(*adInterface);
         }
       }
 
       void getValues(const void* buf, size_t bufOffset, void* primals, size_t bufModOffset, int elements) const {
-        int totalPrimalsOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
-        for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+        forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalPrimalsOffset = (bufModOffset + i) * valuesPerElement;  // primals are lineralized per element
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->getValues(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, primals, totalPrimalsOffset, blockLengths[curType]);
             totalPrimalsOffset += types[curType]->computeActiveElements(blockLengths[curType]);
           }
-        }
+        });
       }
 
       void performReduce(void* buf, void* target, int count, AMPI_Op op, int ranks) const {
         for(int j = 1; j < ranks; ++j) {
-          int totalBufOffset = computeBufOffset(count * j);
+          size_t totalBufOffset = computeBufOffset((size_t)count * j);
 
           MPI_Reduce_local(computeBufferPointer(buf, totalBufOffset), buf, count, this->getMpiType(), op.primalFunction);
         }
@@ -430,8 +440,8 @@ namespace medi {
 
       void copy(void* from, size_t fromOffset, void* to, size_t toOffset, int count) const {
         for(int i = 0; i < count; ++i) {
-          int totalFromOffset = computeBufOffset(i + fromOffset);
-          int totalToOffset = computeBufOffset(i + toOffset);
+          size_t totalFromOffset = computeBufOffset(i + fromOffset);
+          size_t totalToOffset = computeBufOffset(i + toOffset);
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->copy(computeBufferPointer(from, totalFromOffset + blockOffsets[curType]), 0, computeBufferPointer(to, totalToOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
@@ -441,7 +451,7 @@ namespace medi {
 
       void initializeType(void* buf, size_t bufOffset, int elements) const {
         for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->initializeType(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
@@ -451,7 +461,7 @@ namespace medi {
 
       void freeType(void* buf, size_t bufOffset, int elements) const {
         for(int i = 0; i < elements; ++i) {
-          int totalBufOffset = computeBufOffset(i + bufOffset);
+          size_t totalBufOffset = computeBufOffset(i + bufOffset);
 
           for(int curType = 0; curType < nTypes; ++curType) {
             types[curType]->freeType(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
@@ -0,0 +1,112 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#pragma once
+
+#include "async.hpp"
+#include "progressThread.hpp"
+#include "../adjointInterface.hpp"
+#include "../typeDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the deferred reverse mode of the blocking collectives.
+   *
+   * If enabled, the reverse of a blocking collective starts the non-blocking counterpart of its adjoint communication.
+   * The wait and the update of the adjoints are handed to the AD tool with AdjointInterface::deferAdjointUpdate. The AD
+   * tool can then evaluate independent parts of the tape while the communication is in progress.
+   *
+   * Blocking and non-blocking collectives do not match each other. The value needs to be the same on all ranks during
+   * the reverse evaluation. The mode requires MPI 3.0.
+   *
+   * @return Reference to the flag.
+   */
+  inline bool& deferredReverseCollectives() {
+    static bool enabled = false;
+
+    return enabled;
+  }
+
+  /**
+   * @brief Enable or disable the deferred reverse mode of the blocking collectives, see deferredReverseCollectives.
+   * @param[in] enabled  True if the adjoint communication of the blocking collectives is deferred.
+   */
+  inline void setDeferredReverseCollectives(bool enabled) {
+    deferredReverseCollectives() = enabled;
+  }
+
+  /**
+   * @brief The remaining part of the reverse of a blocking collective in the deferred mode.
+   *
+   * The request is used for the non-blocking adjoint communication. The finish function performs the remaining
+   * reverse action of the handle, it updates the adjoints of the indices.
+   */
+  struct DeferredReverseCollective : public DeferredAdjointUpdate {
+      AMPI_Request request;
+      HandleBase* handle;
+      ReverseFunction finishFunc;
+      const void* indices;
+      int elements;
+      AdjointInterface* adjointInterface;
+
+      /**
+       * @brief Create the deferred part of a reverse action.
+       *
+       * @param[in]           handle  The handle of the collective.
+       * @param[in]       finishFunc  The function that completes the reverse action of the handle.
+       * @param[in]          indices  The indices of the adjoints that are updated by the finish function.
+       * @param[in]         elements  The number of indices.
+       * @param[in] adjointInterface  The interface to the AD tool.
+       */
+      DeferredReverseCollective(HandleBase* handle, ReverseFunction finishFunc, const void* indices, int elements,
+                                AdjointInterface* adjointInterface) :
+        request(),
+        handle(handle),
+        finishFunc(finishFunc),
+        indices(indices),
+        elements(elements),
+        adjointInterface(adjointInterface) {}
+
+      const void* getIndices() const {
+        return indices;
+      }
+
+      int getElements() const {
+        return elements;
+      }
+
+      void complete() {
+        waitReverse(&request);
+        finishFunc(handle, adjointInterface);
+      }
+  };
+}
@@ -43,312 +43,486 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Send_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Send_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Send(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Isend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Isend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Isend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Isend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Bsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Bsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Bsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Ibsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Ibsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ssend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Ssend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Ssend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Ssend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Issend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Issend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Issend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Issend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Rsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Rsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Rsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Rsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Irsend_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Irsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Recv_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Recv_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, status);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Recv(bufAdjoints, bufType.count, bufType.type, src, tag, comm, status);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Mrecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Mrecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Mrecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), &message->message, status);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Mrecv(bufAdjoints, bufType.count, bufType.type, &message->message, status);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Irecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Irecv(bufAdjoints, bufType.count, bufType.type, src, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Imrecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Imrecv_fwd(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Imrecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), &message->message, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Imrecv(bufAdjoints, bufType.count, bufType.type, &message->message, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Sendrecv_fwd(typename SENDTYPE::AdjointType* sendbuf, int sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
-                         typename RECVTYPE::AdjointType* recvbuf, int recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
+  void AMPI_Sendrecv_fwd(typename SENDTYPE::AdjointType* sendbuf, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
+                         typename RECVTYPE::AdjointType* recvbuf, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
 #endif
 
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
-    MPI_Sendrecv(sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType(), dest, sendtag, recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType(), source, recvtag, comm, status);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Sendrecv(sendbuf, sendbufType.count, sendbufType.type, dest, sendtag, recvbuf, recvbufType.count, recvbufType.type, source, recvtag, comm, status);
   }
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bcast_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
+  void AMPI_Sendrecv_replace_fwd(typename DATATYPE::AdjointType* buf, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int sendtag, int source, int recvtag, AMPI_Comm comm, AMPI_Status* status) {
+    MEDI_UNUSED(count);
+    LargeCountType bufType(bufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Sendrecv_replace(buf, bufType.count, bufType.type, dest, sendtag, source, recvtag, comm, status);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Bcast_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
 
     if(root == getCommRank(comm)) {
       std::swap(sendbufAdjoints, recvbufAdjoints);
     }
-    MPI_Bcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+    LargeCountType recvbufType(recvbufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Bcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibcast_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibcast_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
 
     if(root == getCommRank(comm)) {
       std::swap(sendbufAdjoints, recvbufAdjoints);
     }
-    MPI_Ibcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    LargeCountType recvbufType(recvbufSize, datatype->getADTool().getAdjointMpiType());
+    MPI_Ibcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatter_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Scatter(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Scatter(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatter_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iscatter(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Iscatter(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatterv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Scatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm);
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    MPI_Scatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatterv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iscatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    MPI_Iscatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Gather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Gather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Igather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Igather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Gatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Gatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Igatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Igatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Allgather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
+  void AMPI_Iallgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iallgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Iallgather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Iallgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Iallgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Alltoall(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Ialltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Ialltoall(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseSparse);
 
-    MPI_Alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm);
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseSparse);
+
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Ialltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The received blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LinearDisplacements linDis(getCommInDegree(comm), recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, linDis.counts, linDis.displs, linDis.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The received blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    LinearDisplacements* linDis = new LinearDisplacements(getCommInDegree(comm), recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, linDis->counts, linDis->displs, linDis->type, comm, &request->request);
+  }
+#endif
 
-    MPI_Ialltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(reverseComm);
+
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(reverseComm);
+
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    NeighborDisplacements linDis(comm, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoallv(sendbufAdjoints, linDis.send.counts, linDis.send.displs, linDis.send.type, recvbufAdjoints, linDis.recv.counts, linDis.recv.displs, linDis.recv.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    NeighborDisplacements* linDis = new NeighborDisplacements(comm, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufSize, recvtype->getADTool().getAdjointMpiType());
+    request->setReverseData(reinterpret_cast<void*>(linDis), NeighborDisplacements::deleteFunc);
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, linDis->send.counts, linDis->send.displs, linDis->send.type, recvbufAdjoints, linDis->recv.counts, linDis->recv.displs, linDis->recv.type, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseComm);
+
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseComm);
+
+    VectorType sendbufType(sendbufVectorSize, sendtype->getADTool().getAdjointMpiType());
+    VectorType recvbufType(recvbufVectorSize, recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Reduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+  void AMPI_Reduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AdjointInterface* adjointInterface) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
+    MEDI_UNUSED(adjointInterface);
     //TODO: MPI_Reduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, root, comm);
     std::cout << "Forward reduce not supported." << std::endl;
   }
@@ -356,19 +530,140 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ireduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ireduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request, AdjointInterface* adjointInterface) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
+    MEDI_UNUSED(adjointInterface);
     //TODO: MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, root, comm, &request->request);
     std::cout << "Forward reduce not supported." << std::endl;
   }
 #endif
 
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  /**
+   * @brief Sum of the tangents of Reduce_scatter for adjoint types without an MPI sum operator.
+   *
+   * The blocks of all ranks for the own segment are received next to each other with an Alltoallv and summed with
+   * AdjointInterface::combineAdjoints. The receive buffer is replaced by a buffer for the blocks of all ranks, the sum
+   * is placed in its first block.
+   */
+  struct ReduceScatterForwardBlocks {
+      int* counts;
+      int* displs;
+      void* adjoints;
+      int elements;
+      int ranks;
+      AdjointInterface* adjointInterface;
+
+      /**
+       * @brief Replace the receive buffer and set up the layout of the blocks.
+       *
+       * @param[in,out] recvbufAdjoints  The receive buffer of the adjoint interface, it is replaced.
+       * @param[in]            elements  The number of active elements of the own segment.
+       * @param[in]                comm  The communicator of the operation.
+       * @param[in]    adjointInterface  The interface for the creation and the sum of the buffers.
+       */
+      ReduceScatterForwardBlocks(void* &recvbufAdjoints, int elements, MPI_Comm comm, AdjointInterface* adjointInterface) :
+        counts(nullptr),
+        displs(nullptr),
+        adjoints(nullptr),
+        elements(elements),
+        ranks(getCommSize(comm)),
+        adjointInterface(adjointInterface) {
+        adjointInterface->deleteAdjointTypeBuffer(recvbufAdjoints);
+        adjointInterface->createAdjointTypeBuffer(recvbufAdjoints, (size_t)elements * ranks);
+        adjoints = recvbufAdjoints;
+
+        counts = new int[ranks];
+        displs = new int[ranks];
+        for(int i = 0; i < ranks; ++i) {
+          counts[i] = elements;
+          displs[i] = i * elements;
+        }
+      }
+
+      ~ReduceScatterForwardBlocks() {
+        delete [] counts;
+        delete [] displs;
+      }
+
+      /**
+       * @brief Sum the received blocks into the first block.
+       */
+      void combine() {
+        adjointInterface->combineAdjoints(adjoints, elements, ranks);
+      }
+
+      /**
+       * @brief Completion function for the non-blocking operation, sums the blocks and deletes the structure.
+       *
+       * @param[in] d  The pointer to a ReduceScatterForwardBlocks structure.
+       */
+      static void combineFunc(void* d) {
+        ReduceScatterForwardBlocks* data = reinterpret_cast<ReduceScatterForwardBlocks*>(d);
+
+        data->combine();
+        delete data;
+      }
+
+    private:
+      ReduceScatterForwardBlocks(const ReduceScatterForwardBlocks&) = delete;
+      ReduceScatterForwardBlocks& operator=(const ReduceScatterForwardBlocks&) = delete;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(recvbufSize);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    // The wrappers only use Reduce_scatter_wrap for the sum, the tangents are summed.
+    MPI_Op sumOp = datatype->getADTool().getAdjointMpiSumOperator();
+    if(MPI_OP_NULL != sumOp) {
+      ScaledCounts scaled(sendbufCounts, getCommSize(comm), sendbufVectorSize);
+      MPI_Reduce_scatter(sendbufAdjoints, recvbufAdjoints, scaled.counts, datatype->getADTool().getAdjointMpiType(), sumOp, comm);
+    } else {
+      ReduceScatterForwardBlocks blocks(reinterpret_cast<void*&>(recvbufAdjoints), sendbufCounts[getCommRank(comm)], comm, adjointInterface);
+      VectorType vectorType(sendbufVectorSize, datatype->getADTool().getAdjointMpiType());
+      MPI_Alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, vectorType.type, blocks.adjoints, blocks.counts, blocks.displs, vectorType.type, comm);
+      blocks.combine();
+    }
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, const int* recvcounts, const int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request, AdjointInterface* adjointInterface) {
+    MEDI_UNUSED(recvbufSize);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    // The wrappers only use Ireduce_scatter_wrap for the sum, the tangents are summed.
+    MPI_Op sumOp = datatype->getADTool().getAdjointMpiSumOperator();
+    if(MPI_OP_NULL != sumOp) {
+      ScaledCounts* scaled = new ScaledCounts(sendbufCounts, getCommSize(comm), sendbufVectorSize);
+      request->setReverseData(reinterpret_cast<void*>(scaled), ScaledCounts::deleteFunc);
+      MPI_Ireduce_scatter(sendbufAdjoints, recvbufAdjoints, scaled->counts, datatype->getADTool().getAdjointMpiType(), sumOp, comm, &request->request);
+    } else {
+      // The blocks are summed when the request is completed in waitReverse.
+      ReduceScatterForwardBlocks* blocks = new ReduceScatterForwardBlocks(reinterpret_cast<void*&>(recvbufAdjoints), sendbufCounts[getCommRank(comm)], comm, adjointInterface);
+      request->setCompletionData(reinterpret_cast<void*>(blocks), ReduceScatterForwardBlocks::combineFunc);
+      VectorType vectorType(sendbufVectorSize, datatype->getADTool().getAdjointMpiType());
+      MPI_Ialltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, vectorType.type, blocks->adjoints, blocks->counts, blocks->displs, vectorType.type, comm, &request->request);
+    }
+  }
+#endif
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Allreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+  void AMPI_Allreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AdjointInterface* adjointInterface) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
+    MEDI_UNUSED(adjointInterface);
 
     //TODO MPI_Allreduce(sendbufAdjoints, datatype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, comm);
     std::cout << "Forward reduce not supported." << std::endl;
@@ -377,9 +672,10 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Iallreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request, AdjointInterface* adjointInterface) {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
+    MEDI_UNUSED(adjointInterface);
 
     //TODO MPI_Iallreduce(sendbufAdjoints, datatype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
     std::cout << "Forward reduce not supported." << std::endl;
@@ -0,0 +1,358 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "deferredReverse.hpp"
+#include "shadowComm.hpp"
+#include "../adToolInterface.h"
+#include "../macros.h"
+#include "../mpiTools.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the hierarchical mode of the reverse collectives.
+   *
+   * The reverse of a broadcast gathers the adjoints of all ranks on the root, the reverse of an Allreduce with an
+   * operator that requires the primals gathers them on all ranks. The gathered blocks are then summed. If the AD tool
+   * provides a sum operator for the adjoint type, the hierarchical mode sums the adjoints during the communication
+   * instead. The ranks of a node sum their adjoints in a shared memory window, the leaders of the nodes reduce the
+   * node sums and the ranks read the result from the window of their node. Only one block per node is sent over the
+   * network.
+   *
+   * The mode applies to the blocking collectives, the deferred and the non-blocking ones keep the flat communication.
+   * The adjoints are communicated with full precision, the transport precision is not applied. The value needs to be
+   * the same on all ranks during the reverse evaluation. The mode requires MPI 3.0.
+   *
+   * @return Reference to the flag.
+   */
+  inline bool& hierarchicalReverseCollectives() {
+    static bool enabled = false;
+
+    return enabled;
+  }
+
+  /**
+   * @brief Enable or disable the hierarchical mode of the reverse collectives, see hierarchicalReverseCollectives.
+   * @param[in] enabled  True if the adjoints of the reverse collectives are summed per node first.
+   */
+  inline void setHierarchicalReverseCollectives(bool enabled) {
+    hierarchicalReverseCollectives() = enabled;
+  }
+
+  /**
+   * @brief Check if the reverse of a blocking collective uses the hierarchical mode.
+   *
+   * The result does not depend on the communicator, it can be evaluated on a subset of the ranks.
+   *
+   * @param[in] adType  The AD tool of the communicated type.
+   * @return True if the adjoints are summed with hierarchicalAdjointSum.
+   */
+  inline bool isHierarchicalReverse(ADToolInterface const* adType) {
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    return hierarchicalReverseCollectives() && !deferredReverseCollectives() &&
+           MPI_OP_NULL != adType->getAdjointMpiSumOperator();
+#else
+    MEDI_UNUSED(adType);
+
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Number of rank blocks that are received in the reverse of a collective with the hierarchical mode.
+   *
+   * @param[in] adType  The AD tool of the communicated type.
+   * @param[in]   comm  The communicator of the operation.
+   * @return One if the adjoints are summed during the communication, otherwise the size of the communicator.
+   */
+  inline int getHierarchicalRankBlocks(ADToolInterface const* adType, MPI_Comm comm) {
+    if(isHierarchicalReverse(adType)) {
+      return 1;
+    } else {
+      return getCommSize(comm);
+    }
+  }
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  /**
+   * @brief The node structure of a user communicator for the hierarchical reverse collectives.
+   *
+   * The communicators are split from the shadow communicator. The node communicator contains the ranks that share
+   * memory, the leader communicator the first rank of each node. The shared window holds one segment per rank of the
+   * node, it is reallocated if a larger one is required. All ranks of a node use the same sizes, since the counts of
+   * the collectives are the same.
+   *
+   * The communicators are freed with the attribute of the user communicator. The window is freed at the beginning of
+   * MPI_Finalize with an attribute on MPI_COMM_SELF, since the attributes of MPI_COMM_WORLD may be deleted after the
+   * windows are no longer available.
+   */
+  struct NodeComms {
+      MPI_Comm nodeComm;
+      MPI_Comm leaderComm;
+      std::vector<int> leaderRanks;  ///< Rank of the node leader in leaderComm for each rank of the communicator.
+
+      MPI_Win window;
+      LargeCount windowBytes;
+      std::vector<char*> segments;
+
+      bool finalizeRegistered;
+      int keyval;
+
+      NodeComms(MPI_Comm comm) :
+        nodeComm(MPI_COMM_NULL),
+        leaderComm(MPI_COMM_NULL),
+        leaderRanks(),
+        window(MPI_WIN_NULL),
+        windowBytes(0),
+        segments(),
+        finalizeRegistered(false),
+        keyval(MPI_KEYVAL_INVALID) {
+        MPI_Comm shadow = getShadowComm(comm);
+        int rank = getCommRank(shadow);
+
+        MPI_Comm_split_type(shadow, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+        int nodeRank = getCommRank(nodeComm);
+        MPI_Comm_split(shadow, 0 == nodeRank ? 0 : MPI_UNDEFINED, rank, &leaderComm);
+
+        int leaderRank = 0;
+        if(MPI_COMM_NULL != leaderComm) {
+          leaderRank = getCommRank(leaderComm);
+        }
+        MPI_Bcast(&leaderRank, 1, MPI_INT, 0, nodeComm);
+
+        leaderRanks.resize(getCommSize(shadow));
+        MPI_Allgather(&leaderRank, 1, MPI_INT, leaderRanks.data(), 1, MPI_INT, shadow);
+      }
+
+      ~NodeComms() {
+        if(finalizeRegistered) {
+          // Frees the window with finalizeFunc.
+          MPI_Comm_delete_attr(MPI_COMM_SELF, keyval);
+        }
+        if(MPI_KEYVAL_INVALID != keyval) {
+          MPI_Comm_free_keyval(&keyval);
+        }
+
+        if(MPI_COMM_NULL != leaderComm) {
+          MPI_Comm_free(&leaderComm);
+        }
+        MPI_Comm_free(&nodeComm);
+      }
+
+      /**
+       * @brief Make sure that each segment of the window has at least the given size, collective over the node.
+       * @param[in] bytes  The size of one segment.
+       */
+      void reserve(LargeCount bytes) {
+        if(bytes <= windowBytes) {
+          return;
+        }
+
+        freeWindow();
+
+        char* base;
+        MPI_Win_allocate_shared((MPI_Aint)bytes, 1, MPI_INFO_NULL, nodeComm, &base, &window);
+
+        segments.resize(getCommSize(nodeComm));
+        for(int i = 0; i < (int)segments.size(); ++i) {
+          MPI_Aint size;
+          int dispUnit;
+          MPI_Win_shared_query(window, i, &size, &dispUnit, &segments[i]);
+        }
+
+        // Passive target epoch for the synchronization with MPI_Win_sync.
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+        windowBytes = bytes;
+
+        if(!finalizeRegistered) {
+          registerFinalize();
+        }
+      }
+
+      /**
+       * @brief Make the stores of all ranks of the node to the window visible to the other ranks.
+       */
+      void sync() {
+        MPI_Win_sync(window);
+        MPI_Barrier(nodeComm);
+        MPI_Win_sync(window);
+      }
+
+    private:
+
+      void registerFinalize() {
+        if(MPI_KEYVAL_INVALID == keyval) {
+          keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, finalizeFunc);
+        }
+        MPI_Comm_set_attr(MPI_COMM_SELF, keyval, reinterpret_cast<void*>(this));
+
+        finalizeRegistered = true;
+      }
+
+      static int finalizeFunc(MPI_Comm comm, int keyval, void* attribute, void* extraState) {
+        MEDI_UNUSED(comm);
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        NodeComms* node = reinterpret_cast<NodeComms*>(attribute);
+        node->freeWindow();
+        node->finalizeRegistered = false;
+
+        return MPI_SUCCESS;
+      }
+
+      void freeWindow() {
+        if(MPI_WIN_NULL != window) {
+          MPI_Win_unlock_all(window);
+          MPI_Win_free(&window);
+          windowBytes = 0;
+        }
+      }
+
+      NodeComms(const NodeComms&) = delete;
+      NodeComms& operator=(const NodeComms&) = delete;
+  };
+
+  /**
+   * @brief Attribute delete function for the node structure of a user communicator.
+   */
+  inline int deleteNodeComms(MPI_Comm comm, int keyval, void* attributeVal, void* extraState) {
+    MEDI_UNUSED(comm);
+    MEDI_UNUSED(keyval);
+    MEDI_UNUSED(extraState);
+
+    delete reinterpret_cast<NodeComms*>(attributeVal);
+
+    return MPI_SUCCESS;
+  }
+
+  /**
+   * @brief Get the node structure of a user communicator.
+   *
+   * The structure is created on the first call and cached as an attribute of the communicator. The call is collective
+   * over the communicator.
+   *
+   * @param[in] comm  The user communicator.
+   * @return The node structure.
+   */
+  inline NodeComms& getNodeComms(MPI_Comm comm) {
+    static int keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, deleteNodeComms);
+
+    NodeComms* node;
+    int flag;
+    MPI_Comm_get_attr(comm, keyval, &node, &flag);
+    if(!flag) {
+      node = new NodeComms(comm);
+      MPI_Comm_set_attr(comm, keyval, node);
+    }
+
+    return *node;
+  }
+
+  /**
+   * @brief Sum the adjoints of all ranks of a communicator with the hierarchical mode.
+   *
+   * The adjoints of the ranks of a node are copied into the shared window. Each rank sums a part of the elements into
+   * the segment of the node leader. The leaders reduce the node sums, in chunks of largeCountLimit elements, and the
+   * result is copied from the segment of the leader.
+   *
+   * @param[in]  sendAdjoints  The adjoints of this rank.
+   * @param[out] recvAdjoints  The sum of the adjoints of all ranks. Only accessed on the ranks that receive the sum.
+   * @param[in]          size  The number of adjoint values, the same on all ranks.
+   * @param[in]          type  The MPI type of the adjoint values.
+   * @param[in]         sumOp  The sum operator for the type.
+   * @param[in]          root  The rank that receives the sum or -1 if all ranks receive it.
+   * @param[in]          comm  The user communicator.
+   */
+  inline void hierarchicalAdjointSum(const void* sendAdjoints, void* recvAdjoints, LargeCount size, MPI_Datatype type,
+                                     MPI_Op sumOp, int root, MPI_Comm comm) {
+    if(0 == size) {
+      return;
+    }
+
+    NodeComms& node = getNodeComms(comm);
+
+    MPI_Aint lb;
+    MPI_Aint extent;
+    MPI_Type_get_extent(type, &lb, &extent);
+
+    node.reserve(size * extent);
+    int nodeRank = getCommRank(node.nodeComm);
+    int nodeSize = getCommSize(node.nodeComm);
+    LargeCount limit = largeCountLimit();
+
+    std::memcpy(node.segments[nodeRank], sendAdjoints, size * extent);
+    node.sync();
+
+    // Sum the part of this rank over all segments of the node into the segment of the leader.
+    LargeCount begin = size * nodeRank / nodeSize;
+    LargeCount end = size * (nodeRank + 1) / nodeSize;
+    for(int i = 1; i < nodeSize; ++i) {
+      for(LargeCount pos = begin; pos < end; pos += limit) {
+        int count = (int)std::min(limit, end - pos);
+        MPI_Reduce_local(node.segments[i] + pos * extent, node.segments[0] + pos * extent, count, type, sumOp);
+      }
+    }
+    node.sync();
+
+    if(MPI_COMM_NULL != node.leaderComm) {
+      int leaderRank = getCommRank(node.leaderComm);
+      for(LargeCount pos = 0; pos < size; pos += limit) {
+        int count = (int)std::min(limit, size - pos);
+        char* nodeSum = node.segments[0] + pos * extent;
+
+        if(-1 == root) {
+          MPI_Allreduce(MPI_IN_PLACE, nodeSum, count, type, sumOp, node.leaderComm);
+        } else if(leaderRank == node.leaderRanks[root]) {
+          MPI_Reduce(MPI_IN_PLACE, nodeSum, count, type, sumOp, node.leaderRanks[root], node.leaderComm);
+        } else {
+          MPI_Reduce(nodeSum, nullptr, count, type, sumOp, node.leaderRanks[root], node.leaderComm);
+        }
+      }
+    }
+    node.sync();
+
+    if(-1 == root || root == getCommRank(comm)) {
+      std::memcpy(recvAdjoints, node.segments[0], size * extent);
+    }
+
+    // The segment of the leader is overwritten by the next call.
+    node.sync();
+  }
+#endif
+}
@@ -91,6 +91,38 @@ namespace medi {
        */
       bool hasAdjoint;
 
+      /**
+       * @brief Indicates if the operator selects one of the input values, e.g. min or max, and the owner of the
+       * selected value can be tracked.
+       *
+       * For such operators the reduction is split. First the rank that provides each result value is determined with
+       * the owner function, afterwards the selected values are only communicated from their owners. The adjoint values
+       * are therefore only send back to the owners in the reverse sweep.
+       */
+      bool hasOwner;
+
+      /**
+       * @brief The mpi operator that determines the owner of each reduced value.
+       *
+       * The operator is evaluated on the buffers created with the packOwnerOperation.
+       */
+      MPI_Op ownerFunction;
+
+      /**
+       * @brief The mpi data type for one element of the owner buffers.
+       */
+      MPI_Datatype ownerMpiType;
+
+      /**
+       * @brief Creates the owner buffer from the user buffer and the primal values of the user buffer.
+       */
+      PackOwnerOperation packOwnerOperation;
+
+      /**
+       * @brief Extracts the owner ranks from a reduced owner buffer.
+       */
+      UnpackOwnerOperation unpackOwnerOperation;
+
       /**
        * @brief Default constructor for static initialization.
        *
@@ -103,7 +135,12 @@ namespace medi {
         modifiedPrimalFunction(MPI_OP_NULL),
         preAdjointOperation(noPreAdjointOperation),
         postAdjointOperation(noPostAdjointOperation),
-        hasAdjoint(false) {}
+        hasAdjoint(false),
+        hasOwner(false),
+        ownerFunction(MPI_OP_NULL),
+        ownerMpiType(MPI_DATATYPE_NULL),
+        packOwnerOperation(nullptr),
+        unpackOwnerOperation(nullptr) {}
 
       /**
        * @brief Creates an operator with a specialized adjoint handling.
@@ -183,10 +220,41 @@ namespace medi {
         this->hasAdjoint = false;
       }
 
+      /**
+       * @brief Adds the owner tracking to an operator that selects one of its input values.
+       *
+       * The reduction of AD types is then performed by determining the owner of each value with the owner function.
+       * Afterwards the values are gathered only from their owners. See hasOwner for details.
+       *
+       * @param[in]        ownerFunction  The mpi function that reduces the owner buffers. It needs to select the
+       *                                  same values as the primal function. Ties have to be resolved deterministic.
+       * @param[in]         ownerMpiType  The committed mpi data type for one element of the owner buffers. The
+       *                                  operator takes the ownership of the type.
+       * @param[in]   packOwnerOperation  Creates the owner buffer from the user buffer and its primal values.
+       * @param[in] unpackOwnerOperation  Extracts the owner ranks from the reduced owner buffer.
+       *
+       * @return Result of MPI_Op_create
+       */
+      int initOwner(MPI_User_function* ownerFunction, MPI_Datatype ownerMpiType, const PackOwnerOperation packOwnerOperation, const UnpackOwnerOperation unpackOwnerOperation) {
+        int result = MPI_Op_create(ownerFunction, 1, &this->ownerFunction);
+
+        this->ownerMpiType = ownerMpiType;
+        this->packOwnerOperation = packOwnerOperation;
+        this->unpackOwnerOperation = unpackOwnerOperation;
+        this->hasOwner = true;
+
+        return result;
+      }
+
       int free() {
         if(this->hasAdjoint) {
           MPI_Op_free(&this->modifiedPrimalFunction);
         }
+        if(this->hasOwner) {
+          MPI_Op_free(&this->ownerFunction);
+          MPI_Type_free(&this->ownerMpiType);
+          this->hasOwner = false;
+        }
 
         return MPI_Op_free(&this->primalFunction);
       }
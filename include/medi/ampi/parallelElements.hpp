@@ -0,0 +1,173 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+#include "../adToolInterface.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the number of elements from which the element loops of the datatypes are run in parallel.
+   *
+   * The loops that extract the indices, primal values and modified values from a buffer and that register the
+   * received values are distributed over the OpenMP threads if a buffer has at least this number of elements. The
+   * loops that create or register indices are only run in parallel if the AD tool supports it, see
+   * ADToolInterface::beginParallelIndexCreation.
+   *
+   * A value of zero disables the parallel loops. The setting has no effect if MeDiPack is compiled without OpenMP, the
+   * loops of callers that are already in a parallel region stay sequential.
+   *
+   * @return Reference to the threshold.
+   */
+  inline int& parallelElementThreshold() {
+    static int threshold = 0;
+
+    return threshold;
+  }
+
+  /**
+   * @brief Set the number of elements from which the element loops of the datatypes are run in parallel.
+   * @param[in] threshold  The minimum number of elements, zero for sequential loops.
+   */
+  inline void setParallelElementThreshold(int threshold) {
+    mediAssert(0 <= threshold);
+    parallelElementThreshold() = threshold;
+  }
+
+  /**
+   * @brief Check if an element loop is run in parallel.
+   * @param[in] elements  The number of elements in the loop.
+   * @return True if OpenMP is available, the threshold is reached and the caller is not in a parallel region.
+   */
+  inline bool isParallelElementLoop(int elements) {
+#ifdef _OPENMP
+    return 0 < parallelElementThreshold() && parallelElementThreshold() <= elements && !omp_in_parallel();
+#else
+    MEDI_UNUSED(elements);
+    return false;
+#endif
+  }
+
+  /**
+   * @brief The state of a parallel index creation.
+   */
+  struct ParallelIndexCreation {
+      /**
+       * @brief True while the indices of an operation are created by several threads.
+       */
+      bool active;
+
+      /**
+       * @brief The offset in the index buffer of the first value in the range of the AD tool.
+       */
+      size_t indexBase;
+  };
+
+  /**
+   * @brief Access to the state of the current parallel index creation.
+   *
+   * The state is set by the thread that starts the element loop and read by the types of the elements, which
+   * compute the position of a value in the reserved range from its offset in the index buffer.
+   *
+   * @return Reference to the state.
+   */
+  inline ParallelIndexCreation& parallelIndexCreation() {
+    static ParallelIndexCreation state = {false, 0};
+
+    return state;
+  }
+
+  /**
+   * @brief Start a parallel index creation if the loop is large enough and the AD tool accepts it.
+   *
+   * @param[in]         adTool  The AD tool that creates the indices.
+   * @param[in]       elements  The number of elements in the loop.
+   * @param[in] activeElements  The number of values that receive an index.
+   * @param[in]      indexBase  The offset in the index buffer of the first value.
+   * @return True if the indices are created with the position aware functions of the AD tool in a parallel loop.
+   */
+  inline bool beginParallelIndices(ADToolInterface const& adTool, int elements, int activeElements, size_t indexBase) {
+    if(isParallelElementLoop(elements) && adTool.beginParallelIndexCreation(activeElements)) {
+      parallelIndexCreation().active = true;
+      parallelIndexCreation().indexBase = indexBase;
+
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Finish a parallel index creation that was started with beginParallelIndices.
+   *
+   * @param[in] adTool  The AD tool that creates the indices.
+   */
+  inline void endParallelIndices(ADToolInterface const& adTool) {
+    parallelIndexCreation().active = false;
+    adTool.endParallelIndexCreation();
+  }
+
+  /**
+   * @brief Call the function for each element, with an OpenMP loop if the parallel flag is set.
+   *
+   * @param[in] elements  The number of elements.
+   * @param[in] parallel  If the elements are distributed over the threads.
+   * @param[in]     func  Called with the element position, needs to be safe for concurrent calls if run in parallel.
+   *
+   * @tparam Func  A callable with the signature void(int).
+   */
+  template<typename Func>
+  inline void forEachElement(int elements, bool parallel, Func const& func) {
+#ifdef _OPENMP
+    if(parallel) {
+#pragma omp parallel for
+      for(int i = 0; i < elements; ++i) {
+        func(i);
+      }
+
+      return;
+    }
+#else
+    MEDI_UNUSED(parallel);
+#endif
+
+    for(int i = 0; i < elements; ++i) {
+      func(i);
+    }
+  }
+}
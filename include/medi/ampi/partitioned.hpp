@@ -0,0 +1,704 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "async.hpp"
+#include "shadowComm.hpp"
+#include "../adToolInterface.h"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  /*
+   * Partitioned communication is handled like the persistent communication. The start of the request records the
+   * handles that open and close the communication of the whole buffer. Each partition of a send records its own
+   * handle when the request is completed, each partition of a receive records its handle when its arrival is detected
+   * (Parrived) or when the request is completed. The reverse communication is also partitioned: a partition's adjoint
+   * is sent as soon as it is complete and is applied as soon as it has arrived.
+   *
+   * Pready only copies the partition into the send buffer and does not access the tape, it can be called from any
+   * thread, e.g. from the worker threads that compute the partitions. Parrived registers the received values on the
+   * tape, it needs to be called from the recording thread like the computations that use the values.
+   *
+   * The reverse direction of a partitioned send from A to B is a partitioned receive on A from B. The reverse requests
+   * are created for each recorded instance, in the same order on both ranks.
+   */
+
+  typedef void (*PartitionFunction)(HandleBase* h, int partition);
+
+  struct PartitionedAsyncHandle : public AsyncHandle {
+      PartitionFunction partitionFunc;
+
+      PartitionedAsyncHandle() :
+        AsyncHandle(),
+        partitionFunc(nullptr) {}
+  };
+
+  /**
+   * @brief Tape entry for one partition of a recorded partitioned request.
+   */
+  struct PartitionAdjointHandle : public HandleBase {
+      AsyncAdjointHandle* adjointHandle;
+      int partition;
+
+      PartitionAdjointHandle(AsyncAdjointHandle* adjointHandle, int partition) :
+        HandleBase(),
+        adjointHandle(adjointHandle),
+        partition(partition) {}
+  };
+
+  /**
+   * @brief Get the adjoint values of a partition in a linear adjoint buffer.
+   *
+   * @param[in]         adjoints  The linear adjoint buffer of all partitions.
+   * @param[in]        partition  The partition.
+   * @param[in]   partitionCount  The number of active elements in each partition.
+   * @param[in] adjointInterface  The interface of the AD tool.
+   * @param[in]           adType  The AD tool of the communicated type.
+   * @return The location of the adjoint values of the partition.
+   */
+  inline void* getPartitionAdjoints(void* adjoints, int partition, int partitionCount,
+                                    AdjointInterface* adjointInterface, ADToolInterface const& adType) {
+    return shiftBuffer(adjoints, partition * partitionCount * adjointInterface->getVectorSize(), adType.getAdjointMpiType());
+  }
+
+  template<typename DATATYPE>
+  struct AMPI_Psend_AdjointHandle : public AsyncAdjointHandle {
+    int bufTotalSize;
+    typename DATATYPE::IndexType* bufIndices;
+    /* required for async */ void* bufAdjoints;
+    int bufCount;
+    LargeCount bufCountVec;
+    int partitions;
+    int count;
+    DATATYPE* datatype;
+    int dest;
+    int tag;
+    AMPI_Comm comm;
+
+    ~AMPI_Psend_AdjointHandle () {
+      if(nullptr != bufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(bufIndices);
+        bufIndices = nullptr;
+      }
+    }
+  };
+
+  template<typename DATATYPE>
+  struct AMPI_Psend_init_AsyncHandle : public PartitionedAsyncHandle {
+    const typename DATATYPE::Type* buf;
+    typename DATATYPE::ModifiedType* bufMod;
+    int partitions;
+    int count;
+    DATATYPE* datatype;
+    int dest;
+    int tag;
+    AMPI_Comm comm;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Psend_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(handle);
+
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize);
+
+    MPI_Psend_init(h->bufAdjoints, h->partitions, h->bufCountVec, h->datatype->getADTool().getAdjointMpiType(), h->dest,
+                   h->tag, h->comm, MPI_INFO_NULL, &h->requestReverse.request);
+    MPI_Start(&h->requestReverse.request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_partition_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    PartitionAdjointHandle* ph = static_cast<PartitionAdjointHandle*>(handle);
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(ph->adjointHandle);
+
+    int offset = ph->partition * h->bufCount;
+    adjointInterface->getAdjoints(&h->bufIndices[offset],
+                                  getPartitionAdjoints(h->bufAdjoints, ph->partition, h->bufCount, adjointInterface,
+                                                       h->datatype->getADTool()),
+                                  h->bufCount);
+
+    MPI_Pready(ph->partition, h->requestReverse.request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    MPI_Request_free(&h->requestReverse.request);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(handle);
+
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize);
+
+    MPI_Precv_init(h->bufAdjoints, h->partitions, h->bufCountVec, h->datatype->getADTool().getAdjointMpiType(), h->dest,
+                   h->tag, getShadowComm(h->comm), MPI_INFO_NULL, &h->requestReverse.request);
+    MPI_Start(&h->requestReverse.request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_partition_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    PartitionAdjointHandle* ph = static_cast<PartitionAdjointHandle*>(handle);
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(ph->adjointHandle);
+
+    int flag = 0;
+    while(!flag) {
+      MPI_Parrived(h->requestReverse.request, ph->partition, &flag);
+    }
+
+    int offset = ph->partition * h->bufCount;
+    adjointInterface->updateAdjoints(&h->bufIndices[offset],
+                                     getPartitionAdjoints(h->bufAdjoints, ph->partition, h->bufCount, adjointInterface,
+                                                          h->datatype->getADTool()),
+                                     h->bufCount);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    MPI_Request_free(&h->requestReverse.request);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Psend_init_ready(HandleBase* handle, int partition) {
+    AMPI_Psend_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Psend_init_AsyncHandle<DATATYPE>*>(handle);
+    DATATYPE* datatype = asyncHandle->datatype;
+    int count = asyncHandle->count;
+
+    if(datatype->isModifiedBufferRequired()) {
+      datatype->copyIntoModifiedBuffer(asyncHandle->buf, partition * count, asyncHandle->bufMod, partition * count, count);
+    }
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Psend_init_preStart(HandleBase* handle) {
+    AMPI_Psend_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Psend_init_AsyncHandle<DATATYPE>*>(handle);
+    DATATYPE* datatype = asyncHandle->datatype;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = nullptr;
+    if(adType->isHandleRequired()) {
+      h = new AMPI_Psend_AdjointHandle<DATATYPE>();
+    }
+    adType->startAssembly(h);
+
+    if(nullptr != h) {
+      // The indices are gathered when the request is completed.
+      h->bufCount = datatype->computeActiveElements(asyncHandle->count);
+      h->bufTotalSize = datatype->computeActiveElements(asyncHandle->partitions * asyncHandle->count);
+      datatype->getADTool().createIndexTypeBuffer(h->bufIndices, h->bufTotalSize);
+
+      h->funcReverse = AMPI_Psend_b<DATATYPE>;
+      h->funcForward = AMPI_Psend_d_finish<DATATYPE>;
+      h->partitions = asyncHandle->partitions;
+      h->count = asyncHandle->count;
+      h->datatype = datatype;
+      h->dest = asyncHandle->dest;
+      h->tag = asyncHandle->tag;
+      h->comm = asyncHandle->comm;
+
+      WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Psend_b_finish<DATATYPE>,
+                                         (ForwardFunction)AMPI_Psend_d<DATATYPE>, h);
+      adType->addToolAction(waitH);
+    }
+
+    asyncHandle->toolHandle = h;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Psend_init_finish(HandleBase* handle) {
+    AMPI_Psend_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Psend_init_AsyncHandle<DATATYPE>*>(handle);
+    AMPI_Psend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Psend_AdjointHandle<DATATYPE>*>(asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(asyncHandle->datatype->getADTool());
+
+    if(nullptr != h) {
+      // The partitions are recorded here and not in Pready, such that Pready can be called from any thread.
+      asyncHandle->datatype->getIndices(asyncHandle->buf, 0, h->bufIndices, 0,
+                                        asyncHandle->partitions * asyncHandle->count);
+
+      for(int i = 0; i < asyncHandle->partitions; ++i) {
+        PartitionAdjointHandle* ph = new PartitionAdjointHandle(h, i);
+        ph->funcReverse = AMPI_Psend_partition_b<DATATYPE>;
+        ph->funcForward = AMPI_Psend_partition_d<DATATYPE>;
+        adType->addToolAction(ph);
+      }
+    }
+
+    adType->addToolAction(h);
+    adType->stopAssembly(h);
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Psend_init_postEnd(HandleBase* handle) {
+    AMPI_Psend_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Psend_init_AsyncHandle<DATATYPE>*>(handle);
+
+    if(asyncHandle->datatype->isModifiedBufferRequired()) {
+      asyncHandle->datatype->deleteModifiedTypeBuffer(asyncHandle->bufMod);
+    }
+
+    delete asyncHandle;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Psend_init(const typename DATATYPE::Type* buf, int partitions, AMPI_Count count, DATATYPE* datatype,
+                      int dest, int tag, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Psend_init(buf, partitions, count, datatype->getMpiType(), dest, tag, comm, info, &request->request);
+    } else {
+      if((LargeCount)partitions * count > INT_MAX) {
+        MEDI_EXCEPTION("Partitioned requests with more than INT_MAX elements are not supported for active types.");
+      }
+
+      typename DATATYPE::ModifiedType* bufMod = nullptr;
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->createModifiedTypeBuffer(bufMod, partitions * count);
+      } else {
+        bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
+      }
+
+      rStatus = MPI_Psend_init(bufMod, partitions, count, datatype->getModifiedMpiType(), dest, tag, comm, info,
+                               &request->request);
+
+      AMPI_Psend_init_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Psend_init_AsyncHandle<DATATYPE>();
+      asyncHandle->buf = buf;
+      asyncHandle->bufMod = bufMod;
+      asyncHandle->partitions = partitions;
+      asyncHandle->count = (int)count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->dest = dest;
+      asyncHandle->tag = tag;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = nullptr;
+      asyncHandle->partitionFunc = (PartitionFunction)AMPI_Psend_init_ready<DATATYPE>;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Psend_init_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Psend_init_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Psend_init_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  struct AMPI_Precv_AdjointHandle : public AsyncAdjointHandle {
+    int bufTotalSize;
+    typename DATATYPE::IndexType* bufIndices;
+    typename DATATYPE::PrimalType* bufOldPrimals;
+    /* required for async */ void* bufAdjoints;
+    int bufCount;
+    LargeCount bufCountVec;
+    int partitions;
+    int count;
+    DATATYPE* datatype;
+    int source;
+    int tag;
+    AMPI_Comm comm;
+
+    /** @brief The partitions that were registered in the wait call and not by Parrived. */
+    std::vector<int> waitPartitions;
+
+    ~AMPI_Precv_AdjointHandle () {
+      if(nullptr != bufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(bufIndices);
+        bufIndices = nullptr;
+      }
+      if(nullptr != bufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(bufOldPrimals);
+        bufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename DATATYPE>
+  struct AMPI_Precv_init_AsyncHandle : public PartitionedAsyncHandle {
+    typename DATATYPE::Type* buf;
+    typename DATATYPE::ModifiedType* bufMod;
+    int partitions;
+    int count;
+    DATATYPE* datatype;
+    int source;
+    int tag;
+    AMPI_Comm comm;
+
+    /** @brief The partitions of the current instance that are already registered. */
+    std::vector<bool> arrived;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Precv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(handle);
+
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize);
+
+    MPI_Precv_init(h->bufAdjoints, h->partitions, h->bufCountVec, h->datatype->getADTool().getAdjointMpiType(), h->source,
+                   h->tag, h->comm, MPI_INFO_NULL, &h->requestReverse.request);
+    MPI_Start(&h->requestReverse.request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_updatePartition_d(AMPI_Precv_AdjointHandle<DATATYPE>* h, int partition,
+                                    AdjointInterface* adjointInterface) {
+    int offset = partition * h->bufCount;
+    adjointInterface->updateAdjoints(&h->bufIndices[offset],
+                                     getPartitionAdjoints(h->bufAdjoints, partition, h->bufCount, adjointInterface,
+                                                          h->datatype->getADTool()),
+                                     h->bufCount);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_partition_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    PartitionAdjointHandle* ph = static_cast<PartitionAdjointHandle*>(handle);
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(ph->adjointHandle);
+
+    int flag = 0;
+    while(!flag) {
+      MPI_Parrived(h->requestReverse.request, ph->partition, &flag);
+    }
+
+    AMPI_Precv_updatePartition_d(h, ph->partition, adjointInterface);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    MPI_Request_free(&h->requestReverse.request);
+
+    for(size_t i = 0; i < h->waitPartitions.size(); ++i) {
+      AMPI_Precv_updatePartition_d(h, h->waitPartitions[i], adjointInterface);
+    }
+
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_readyPartition_b(AMPI_Precv_AdjointHandle<DATATYPE>* h, int partition,
+                                   AdjointInterface* adjointInterface) {
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    int offset = partition * h->bufCount;
+
+    adjointInterface->getAdjoints(&h->bufIndices[offset],
+                                  getPartitionAdjoints(h->bufAdjoints, partition, h->bufCount, adjointInterface,
+                                                       h->datatype->getADTool()),
+                                  h->bufCount);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(&h->bufIndices[offset], &h->bufOldPrimals[offset], h->bufCount);
+    }
+
+    MPI_Pready(partition, h->requestReverse.request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(handle);
+
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize);
+
+    MPI_Psend_init(h->bufAdjoints, h->partitions, h->bufCountVec, h->datatype->getADTool().getAdjointMpiType(), h->source,
+                   h->tag, getShadowComm(h->comm), MPI_INFO_NULL, &h->requestReverse.request);
+    MPI_Start(&h->requestReverse.request);
+
+    // The values registered in the wait call are used only after it, their adjoints are complete.
+    for(size_t i = 0; i < h->waitPartitions.size(); ++i) {
+      AMPI_Precv_readyPartition_b(h, h->waitPartitions[i], adjointInterface);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_partition_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    PartitionAdjointHandle* ph = static_cast<PartitionAdjointHandle*>(handle);
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(ph->adjointHandle);
+
+    AMPI_Precv_readyPartition_b(h, ph->partition, adjointInterface);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(handle);
+
+    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    MPI_Request_free(&h->requestReverse.request);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  /**
+   * @brief Copy a partition into the user buffer and register its values.
+   */
+  template<typename DATATYPE>
+  void AMPI_Precv_init_registerPartition(AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle, int partition) {
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(asyncHandle->toolHandle);
+    DATATYPE* datatype = asyncHandle->datatype;
+    int count = asyncHandle->count;
+
+    asyncHandle->arrived[partition] = true;
+
+    if(datatype->isModifiedBufferRequired()) {
+      datatype->copyFromModifiedBuffer(asyncHandle->buf, partition * count, asyncHandle->bufMod, partition * count, count);
+    }
+
+    if(nullptr != h) {
+      datatype->registerValue(asyncHandle->buf, partition * count, h->bufIndices, h->bufOldPrimals, partition * count,
+                              count);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Precv_init_arrived(HandleBase* handle, int partition) {
+    AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Precv_init_AsyncHandle<DATATYPE>*>(handle);
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(asyncHandle->datatype->getADTool());
+
+    if(asyncHandle->arrived[partition]) {
+      return;
+    }
+
+    if(nullptr != h) {
+      PartitionAdjointHandle* ph = new PartitionAdjointHandle(h, partition);
+      ph->funcReverse = AMPI_Precv_partition_b<DATATYPE>;
+      ph->funcForward = AMPI_Precv_partition_d<DATATYPE>;
+      adType->addToolAction(ph);
+    }
+
+    AMPI_Precv_init_registerPartition(asyncHandle, partition);
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Precv_init_preStart(HandleBase* handle) {
+    AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Precv_init_AsyncHandle<DATATYPE>*>(handle);
+    DATATYPE* datatype = asyncHandle->datatype;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    int totalCount = asyncHandle->partitions * asyncHandle->count;
+
+    asyncHandle->arrived.assign(asyncHandle->partitions, false);
+
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = nullptr;
+    if(adType->isHandleRequired()) {
+      h = new AMPI_Precv_AdjointHandle<DATATYPE>();
+    }
+    adType->startAssembly(h);
+
+    if(nullptr != h) {
+      h->bufCount = datatype->computeActiveElements(asyncHandle->count);
+      h->bufTotalSize = datatype->computeActiveElements(totalCount);
+      datatype->getADTool().createIndexTypeBuffer(h->bufIndices, h->bufTotalSize);
+
+      // extract the old primal values from the recv buffer if the AD tool
+      // needs the primal values reset
+      if(adType->isOldPrimalsRequired()) {
+        datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
+        datatype->getValues(asyncHandle->buf, 0, h->bufOldPrimals, 0, totalCount);
+      }
+
+      datatype->createIndices(asyncHandle->buf, 0, h->bufIndices, 0, totalCount);
+
+      h->funcReverse = AMPI_Precv_b<DATATYPE>;
+      h->funcForward = AMPI_Precv_d_finish<DATATYPE>;
+      h->partitions = asyncHandle->partitions;
+      h->count = asyncHandle->count;
+      h->datatype = datatype;
+      h->source = asyncHandle->source;
+      h->tag = asyncHandle->tag;
+      h->comm = asyncHandle->comm;
+
+      WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Precv_b_finish<DATATYPE>,
+                                         (ForwardFunction)AMPI_Precv_d<DATATYPE>, h);
+      adType->addToolAction(waitH);
+    }
+
+    if(!datatype->isModifiedBufferRequired()) {
+      datatype->clearIndices(asyncHandle->buf, 0, totalCount);
+    }
+
+    asyncHandle->toolHandle = h;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Precv_init_finish(HandleBase* handle) {
+    AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Precv_init_AsyncHandle<DATATYPE>*>(handle);
+    AMPI_Precv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Precv_AdjointHandle<DATATYPE>*>(asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(asyncHandle->datatype->getADTool());
+
+    adType->addToolAction(h);
+
+    for(int i = 0; i < asyncHandle->partitions; ++i) {
+      if(!asyncHandle->arrived[i]) {
+        if(nullptr != h) {
+          h->waitPartitions.push_back(i);
+        }
+        AMPI_Precv_init_registerPartition(asyncHandle, i);
+      }
+    }
+
+    adType->stopAssembly(h);
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Precv_init_postEnd(HandleBase* handle) {
+    AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Precv_init_AsyncHandle<DATATYPE>*>(handle);
+
+    if(asyncHandle->datatype->isModifiedBufferRequired()) {
+      asyncHandle->datatype->deleteModifiedTypeBuffer(asyncHandle->bufMod);
+    }
+
+    delete asyncHandle;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Precv_init(typename DATATYPE::Type* buf, int partitions, AMPI_Count count, DATATYPE* datatype, int source,
+                      int tag, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Precv_init(buf, partitions, count, datatype->getMpiType(), source, tag, comm, info, &request->request);
+    } else {
+      if((LargeCount)partitions * count > INT_MAX) {
+        MEDI_EXCEPTION("Partitioned requests with more than INT_MAX elements are not supported for active types.");
+      }
+
+      typename DATATYPE::ModifiedType* bufMod = nullptr;
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->createModifiedTypeBuffer(bufMod, partitions * count);
+      } else {
+        bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(buf);
+      }
+
+      rStatus = MPI_Precv_init(bufMod, partitions, count, datatype->getModifiedMpiType(), source, tag, comm, info,
+                               &request->request);
+
+      AMPI_Precv_init_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Precv_init_AsyncHandle<DATATYPE>();
+      asyncHandle->buf = buf;
+      asyncHandle->bufMod = bufMod;
+      asyncHandle->partitions = partitions;
+      asyncHandle->count = (int)count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->source = source;
+      asyncHandle->tag = tag;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = nullptr;
+      asyncHandle->partitionFunc = (PartitionFunction)AMPI_Precv_init_arrived<DATATYPE>;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Precv_init_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Precv_init_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Precv_init_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+
+  inline int AMPI_Pready(int partition, AMPI_Request* request) {
+    if(nullptr != request->handle) {
+      PartitionedAsyncHandle* handle = static_cast<PartitionedAsyncHandle*>(request->handle);
+      handle->partitionFunc(handle, partition);
+    }
+
+    return MPI_Pready(partition, request->request);
+  }
+
+  inline int AMPI_Pready_range(int partition_low, int partition_high, AMPI_Request* request) {
+    if(nullptr != request->handle) {
+      PartitionedAsyncHandle* handle = static_cast<PartitionedAsyncHandle*>(request->handle);
+      for(int i = partition_low; i <= partition_high; ++i) {
+        handle->partitionFunc(handle, i);
+      }
+    }
+
+    return MPI_Pready_range(partition_low, partition_high, request->request);
+  }
+
+  inline int AMPI_Pready_list(int length, const int* array_of_partitions, AMPI_Request* request) {
+    if(nullptr != request->handle) {
+      PartitionedAsyncHandle* handle = static_cast<PartitionedAsyncHandle*>(request->handle);
+      for(int i = 0; i < length; ++i) {
+        handle->partitionFunc(handle, array_of_partitions[i]);
+      }
+    }
+
+    return MPI_Pready_list(length, array_of_partitions, request->request);
+  }
+
+  inline int AMPI_Parrived(AMPI_Request* request, int partition, int* flag) {
+    int rStatus = MPI_Parrived(request->request, partition, flag);
+
+    if(*flag && nullptr != request->handle) {
+      PartitionedAsyncHandle* handle = static_cast<PartitionedAsyncHandle*>(request->handle);
+      handle->partitionFunc(handle, partition);
+    }
+
+    return rStatus;
+  }
+#endif
+}
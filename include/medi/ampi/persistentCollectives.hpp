@@ -0,0 +1,641 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include "async.hpp"
+#include "shadowComm.hpp"
+#include "wrappers.hpp"
+#include "../adToolInterface.h"
+#include "../exceptions.hpp"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+#include "../generated/ampiFunctions.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  /*
+   * The persistent collectives record the same handles as their non-blocking counterparts, e.g. a started
+   * Allreduce_init request is recorded like an Iallreduce. Only the reverse communication is different: it is a
+   * persistent request as well, which is shared by all instances that are recorded for the same AMPI request. It is
+   * created on the first reverse evaluation and started for each instance, so the setup is done once per tape and not
+   * once per call.
+   *
+   * The forward and primal evaluations use the functions of the non-blocking collective.
+   */
+
+  /**
+   * @brief Persistent reverse communication shared by all recorded instances of a persistent collective.
+   *
+   * The request and the adjoint buffers are created for the vector size of the first evaluation. They are recreated if
+   * the vector size changes. The state is deleted with the last handle that references it.
+   */
+  struct PersistentCollectiveReverse {
+      int refCount;
+      int vectorSize;
+      MPI_Request request;
+
+      void* sendAdjoints;
+      void* recvAdjoints;
+      LargeCountType* sendType;
+      LargeCountType* recvType;
+
+      PersistentCollectiveReverse() :
+        refCount(1),
+        vectorSize(0),
+        request(MPI_REQUEST_NULL),
+        sendAdjoints(nullptr),
+        recvAdjoints(nullptr),
+        sendType(nullptr),
+        recvType(nullptr) {}
+
+      ~PersistentCollectiveReverse() {
+        destroy();
+      }
+
+      /**
+       * @brief Check if the request and the buffers are valid for the vector size.
+       */
+      bool isCreated(int vecSize) const {
+        return vectorSize == vecSize;
+      }
+
+      /**
+       * @brief Create the adjoint buffers and the count and type pairs for the reverse request.
+       *
+       * The buffers are not created for a zero size, the caller has to create the request afterwards.
+       */
+      void createBuffers(int vecSize, int sendTotalSize, int recvTotalSize, MPI_Datatype adjointType) {
+        destroy();
+
+        vectorSize = vecSize;
+        sendAdjoints = createBuffer((LargeCount)vecSize * sendTotalSize, adjointType);
+        recvAdjoints = createBuffer((LargeCount)vecSize * recvTotalSize, adjointType);
+      }
+
+      void destroy() {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if(MPI_REQUEST_NULL != request && !finalized) {
+          MPI_Request_free(&request);
+        }
+        delete [] reinterpret_cast<char*>(sendAdjoints);
+        delete [] reinterpret_cast<char*>(recvAdjoints);
+        delete sendType;
+        delete recvType;
+
+        request = MPI_REQUEST_NULL;
+        sendAdjoints = nullptr;
+        recvAdjoints = nullptr;
+        sendType = nullptr;
+        recvType = nullptr;
+        vectorSize = 0;
+      }
+
+      static void acquire(PersistentCollectiveReverse* state) {
+        state->refCount += 1;
+      }
+
+      static void release(PersistentCollectiveReverse* state) {
+        state->refCount -= 1;
+        if(0 == state->refCount) {
+          delete state;
+        }
+      }
+
+    private:
+
+      static void* createBuffer(LargeCount elements, MPI_Datatype type) {
+        if(0 == elements) {
+          return nullptr;
+        }
+
+        MPI_Aint lb;
+        MPI_Aint extent;
+        MPI_Type_get_extent(type, &lb, &extent);
+
+        return new char[elements * extent];
+      }
+  };
+
+  template<typename DATATYPE>
+  struct AMPI_Allreduce_init_AdjointHandle : public AMPI_Iallreduce_global_AdjointHandle<DATATYPE> {
+      PersistentCollectiveReverse* reverse;
+
+      ~AMPI_Allreduce_init_AdjointHandle() {
+        PersistentCollectiveReverse::release(reverse);
+      }
+  };
+
+  template<typename DATATYPE>
+  struct AMPI_Allreduce_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod;
+    typename DATATYPE::Type* recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod;
+    int count;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    AMPI_Comm comm;
+    PersistentCollectiveReverse* reverse;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Allreduce_init_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Allreduce_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    PersistentCollectiveReverse* reverse = h->reverse;
+    int vecSize = adjointInterface->getVectorSize();
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+
+    h->recvbufCountVec = (LargeCount)vecSize * h->recvbufCount;
+    h->sendbufCountVec = (LargeCount)vecSize * h->sendbufCount;
+    if(!reverse->isCreated(vecSize)) {
+      MPI_Datatype adjointType = h->datatype->getADTool().getAdjointMpiType();
+      reverse->createBuffers(vecSize, h->sendbufTotalSize * getCommSize(h->comm), h->recvbufTotalSize, adjointType);
+      reverse->recvType = new LargeCountType(h->recvbufCountVec, adjointType);
+      reverse->sendType = new LargeCountType(h->sendbufCountVec, adjointType);
+
+      MPI_Allgather_init(reverse->recvAdjoints, reverse->recvType->count, reverse->recvType->type, reverse->sendAdjoints,
+                         reverse->sendType->count, reverse->sendType->type, getShadowComm(h->comm), MPI_INFO_NULL,
+                         &reverse->request);
+    }
+    h->recvbufAdjoints = reverse->recvAdjoints;
+    h->sendbufAdjoints = reverse->sendAdjoints;
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, vecSize);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+
+    MPI_Start(&reverse->request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Allreduce_init_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Allreduce_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+
+    MPI_Wait(&h->reverse->request, MPI_STATUS_IGNORE);
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+    // the buffers belong to the persistent request
+    h->sendbufAdjoints = nullptr;
+    h->recvbufAdjoints = nullptr;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_preStart(HandleBase* handle) {
+    AMPI_Allreduce_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Allreduce_init_AsyncHandle<DATATYPE>*>
+      (handle);
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(asyncHandle->op);
+
+    AMPI_Allreduce_init_AdjointHandle<DATATYPE>* h = nullptr;
+    if(adType->isHandleRequired()) {
+      h = new AMPI_Allreduce_init_AdjointHandle<DATATYPE>();
+      h->reverse = asyncHandle->reverse;
+      PersistentCollectiveReverse::acquire(h->reverse);
+    }
+    adType->startAssembly(h);
+    if(datatype->isModifiedBufferRequired()) {
+      if(AMPI_IN_PLACE != sendbuf) {
+        datatype->copyIntoModifiedBuffer(sendbuf, 0, asyncHandle->sendbufMod, 0, count);
+      } else {
+        datatype->copyIntoModifiedBuffer(recvbuf, 0, asyncHandle->recvbufMod, 0, count);
+      }
+    }
+
+    if(nullptr != h) {
+      h->sendbufCount = datatype->computeActiveElements(count);
+      h->sendbufTotalSize = datatype->computeActiveElements(count);
+      datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+      h->recvbufCount = datatype->computeActiveElements(count);
+      h->recvbufTotalSize = datatype->computeActiveElements(count);
+      datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+      // extract the primal values for the operator if required
+      if(convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
+        } else {
+          datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
+        }
+      }
+
+      // extract the old primal values from the recv buffer if the AD tool
+      // needs the primal values reset
+      if(adType->isOldPrimalsRequired()) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
+      }
+
+      if(AMPI_IN_PLACE != sendbuf) {
+        datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
+      } else {
+        datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
+      }
+
+      datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+
+      h->funcReverse = AMPI_Allreduce_init_b<DATATYPE>;
+      h->funcForward = AMPI_Iallreduce_global_d_finish<DATATYPE>;
+      h->funcPrimal = AMPI_Iallreduce_global_p_finish<DATATYPE>;
+      h->count = count;
+      h->datatype = datatype;
+      h->op = asyncHandle->op;
+      h->comm = asyncHandle->comm;
+    }
+
+    if(!datatype->isModifiedBufferRequired()) {
+      datatype->clearIndices(recvbuf, 0, count);
+    }
+
+    asyncHandle->toolHandle = h;
+
+    if(nullptr != h) {
+      WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Allreduce_init_b_finish<DATATYPE>,
+                                         (ForwardFunction)AMPI_Iallreduce_global_d<DATATYPE>, h);
+      adType->addToolAction(waitH);
+    }
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_finish(HandleBase* handle) {
+    AMPI_Allreduce_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Allreduce_init_AsyncHandle<DATATYPE>*>
+      (handle);
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Allreduce_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_AdjointHandle<DATATYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(asyncHandle->op);
+
+    adType->addToolAction(h);
+
+    if(datatype->isModifiedBufferRequired()) {
+      datatype->copyFromModifiedBuffer(recvbuf, 0, asyncHandle->recvbufMod, 0, count);
+    }
+
+    if(nullptr != h) {
+      // handle the recv buffers
+      datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+    }
+    // extract the primal values for the operator if required
+    if(nullptr != h && convOp.requiresPrimal) {
+      datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+      datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
+    }
+
+    adType->stopAssembly(h);
+
+    asyncHandle->toolHandle = nullptr;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_postEnd(HandleBase* handle) {
+    AMPI_Allreduce_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Allreduce_init_AsyncHandle<DATATYPE>*>
+      (handle);
+    DATATYPE* datatype = asyncHandle->datatype;
+
+    if(datatype->isModifiedBufferRequired() && !(AMPI_IN_PLACE == asyncHandle->sendbuf)) {
+      datatype->deleteModifiedTypeBuffer(asyncHandle->sendbufMod);
+    }
+    if(datatype->isModifiedBufferRequired()) {
+      datatype->deleteModifiedTypeBuffer(asyncHandle->recvbufMod);
+    }
+
+    PersistentCollectiveReverse::release(asyncHandle->reverse);
+    delete asyncHandle;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                          int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Info info,
+                          AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(op);
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Allreduce_init(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm, info,
+                                   &request->request);
+    } else {
+      if(!convOp.hasAdjoint) {
+        MEDI_EXCEPTION("Persistent reductions are only supported for operators with an adjoint implementation.");
+      }
+
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      if(datatype->isModifiedBufferRequired() && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->createModifiedTypeBuffer(sendbufMod, count);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->createModifiedTypeBuffer(recvbufMod, count);
+      } else {
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(recvbuf);
+      }
+
+      rStatus = MPI_Allreduce_init(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(),
+                                   convOp.modifiedPrimalFunction, comm, info, &request->request);
+
+      AMPI_Allreduce_init_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Allreduce_init_AsyncHandle<DATATYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->count = count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->op = op;
+      asyncHandle->comm = comm;
+      asyncHandle->reverse = new PersistentCollectiveReverse();
+      asyncHandle->toolHandle = nullptr;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Allreduce_init_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Allreduce_init_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Allreduce_init_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  struct AMPI_Bcast_init_AdjointHandle : public AMPI_Ibcast_wrap_AdjointHandle<DATATYPE> {
+      PersistentCollectiveReverse* reverse;
+
+      ~AMPI_Bcast_init_AdjointHandle() {
+        PersistentCollectiveReverse::release(reverse);
+      }
+  };
+
+  template<typename DATATYPE>
+  struct AMPI_Bcast_init_AsyncHandle : public AsyncHandle {
+    typename DATATYPE::Type* buffer;
+    typename DATATYPE::ModifiedType* bufferMod;
+    int count;
+    DATATYPE* datatype;
+    int root;
+    AMPI_Comm comm;
+    PersistentCollectiveReverse* reverse;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Bcast_init_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Bcast_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bcast_init_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    PersistentCollectiveReverse* reverse = h->reverse;
+    int vecSize = adjointInterface->getVectorSize();
+    bool isRoot = h->root == getCommRank(h->comm);
+
+    h->bufferRecvCountVec = (LargeCount)vecSize * h->bufferRecvCount;
+    h->bufferSendCountVec = (LargeCount)vecSize * h->bufferSendCount;
+    if(!reverse->isCreated(vecSize)) {
+      MPI_Datatype adjointType = h->datatype->getADTool().getAdjointMpiType();
+      int sendTotalSize = 0;
+      if(isRoot) {
+        sendTotalSize = h->bufferSendTotalSize * getCommSize(h->comm);
+      }
+      reverse->createBuffers(vecSize, sendTotalSize, h->bufferRecvTotalSize, adjointType);
+      reverse->recvType = new LargeCountType(h->bufferRecvCountVec, adjointType);
+      reverse->sendType = new LargeCountType(h->bufferSendCountVec, adjointType);
+
+      MPI_Gather_init(reverse->recvAdjoints, reverse->recvType->count, reverse->recvType->type, reverse->sendAdjoints,
+                      reverse->sendType->count, reverse->sendType->type, h->root, getShadowComm(h->comm), MPI_INFO_NULL,
+                      &reverse->request);
+    }
+    h->bufferRecvAdjoints = reverse->recvAdjoints;
+    h->bufferSendAdjoints = reverse->sendAdjoints;
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->bufferRecvIndices, h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+    }
+
+    MPI_Start(&reverse->request);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Bcast_init_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Bcast_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bcast_init_AdjointHandle<DATATYPE>*>(handle);
+
+    MPI_Wait(&h->reverse->request, MPI_STATUS_IGNORE);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getCommSize(h->comm));
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->updateAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
+    }
+
+    // the buffers belong to the persistent request
+    h->bufferSendAdjoints = nullptr;
+    h->bufferRecvAdjoints = nullptr;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_preStart(HandleBase* handle) {
+    AMPI_Bcast_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Bcast_init_AsyncHandle<DATATYPE>*>(handle);
+    typename DATATYPE::Type* buffer = asyncHandle->buffer;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    AMPI_Bcast_init_AdjointHandle<DATATYPE>* h = nullptr;
+    if(adType->isHandleRequired()) {
+      h = new AMPI_Bcast_init_AdjointHandle<DATATYPE>();
+      h->reverse = asyncHandle->reverse;
+      PersistentCollectiveReverse::acquire(h->reverse);
+    }
+    adType->startAssembly(h);
+    if(root == getCommRank(comm)) {
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->copyIntoModifiedBuffer(buffer, 0, asyncHandle->bufferMod, 0, count);
+      }
+    }
+
+    if(nullptr != h) {
+      if(root == getCommRank(comm)) {
+        h->bufferSendCount = datatype->computeActiveElements(count);
+        h->bufferSendTotalSize = datatype->computeActiveElements(count);
+        datatype->getADTool().createIndexTypeBuffer(h->bufferSendIndices, h->bufferSendTotalSize);
+      }
+      h->bufferRecvCount = datatype->computeActiveElements(count);
+      h->bufferRecvTotalSize = datatype->computeActiveElements(count);
+      datatype->getADTool().createIndexTypeBuffer(h->bufferRecvIndices, h->bufferRecvTotalSize);
+
+      // extract the old primal values from the recv buffer if the AD tool
+      // needs the primal values reset
+      if(adType->isOldPrimalsRequired()) {
+        datatype->getADTool().createPrimalTypeBuffer(h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+        datatype->getValues(buffer, 0, h->bufferRecvOldPrimals, 0, count);
+      }
+
+      if(root == getCommRank(comm)) {
+        datatype->getIndices(buffer, 0, h->bufferSendIndices, 0, count);
+      }
+
+      datatype->createIndices(buffer, 0, h->bufferRecvIndices, 0, count);
+
+      h->funcReverse = AMPI_Bcast_init_b<DATATYPE>;
+      h->funcForward = AMPI_Ibcast_wrap_d_finish<DATATYPE>;
+      h->funcPrimal = AMPI_Ibcast_wrap_p_finish<DATATYPE>;
+      h->count = count;
+      h->datatype = datatype;
+      h->root = root;
+      h->comm = comm;
+    }
+
+    if(!datatype->isModifiedBufferRequired()) {
+      datatype->clearIndices(buffer, 0, count);
+    }
+
+    asyncHandle->toolHandle = h;
+
+    if(nullptr != h) {
+      WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Bcast_init_b_finish<DATATYPE>,
+                                         (ForwardFunction)AMPI_Ibcast_wrap_d<DATATYPE>, h);
+      adType->addToolAction(waitH);
+    }
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_finish(HandleBase* handle) {
+    AMPI_Bcast_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Bcast_init_AsyncHandle<DATATYPE>*>(handle);
+    typename DATATYPE::Type* buffer = asyncHandle->buffer;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Bcast_init_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bcast_init_AdjointHandle<DATATYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    adType->addToolAction(h);
+
+    if(datatype->isModifiedBufferRequired()) {
+      datatype->copyFromModifiedBuffer(buffer, 0, asyncHandle->bufferMod, 0, count);
+    }
+
+    if(nullptr != h) {
+      // handle the recv buffers
+      datatype->registerValue(buffer, 0, h->bufferRecvIndices, h->bufferRecvOldPrimals, 0, count);
+    }
+
+    adType->stopAssembly(h);
+
+    asyncHandle->toolHandle = nullptr;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_postEnd(HandleBase* handle) {
+    AMPI_Bcast_init_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Bcast_init_AsyncHandle<DATATYPE>*>(handle);
+
+    if(asyncHandle->datatype->isModifiedBufferRequired()) {
+      asyncHandle->datatype->deleteModifiedTypeBuffer(asyncHandle->bufferMod);
+    }
+
+    PersistentCollectiveReverse::release(asyncHandle->reverse);
+    delete asyncHandle;
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init(typename DATATYPE::Type* buffer, int count, DATATYPE* datatype, int root, AMPI_Comm comm,
+                      AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Bcast_init(buffer, count, datatype->getMpiType(), root, comm, info, &request->request);
+    } else {
+      typename DATATYPE::ModifiedType* bufferMod = nullptr;
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->createModifiedTypeBuffer(bufferMod, count);
+      } else {
+        bufferMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(buffer);
+      }
+
+      rStatus = MPI_Bcast_init(bufferMod, count, datatype->getModifiedMpiType(), root, comm, info, &request->request);
+
+      AMPI_Bcast_init_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Bcast_init_AsyncHandle<DATATYPE>();
+      asyncHandle->buffer = buffer;
+      asyncHandle->bufferMod = bufferMod;
+      asyncHandle->count = count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->reverse = new PersistentCollectiveReverse();
+      asyncHandle->toolHandle = nullptr;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Bcast_init_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Bcast_init_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Bcast_init_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+#endif
+}
@@ -43,290 +43,338 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Send_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Send_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Send(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Send(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Isend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Isend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Isend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Isend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bsend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Bsend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Bsend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Bsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibsend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibsend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Ibsend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Ibsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ssend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Ssend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Ssend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Ssend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Issend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Issend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Issend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Issend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Rsend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Rsend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Rsend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Rsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irsend_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Irsend_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irsend(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), dest, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Irsend(bufAdjoints, bufType.count, bufType.type, dest, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Recv_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Recv_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), src, tag, comm, status);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Recv(bufAdjoints, bufType.count, bufType.type, src, tag, comm, status);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Mrecv_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Mrecv_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Mrecv(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), &message->message, status);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Mrecv(bufAdjoints, bufType.count, bufType.type, &message->message, status);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irecv_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Irecv_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), src, tag, comm, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Irecv(bufAdjoints, bufType.count, bufType.type, src, tag, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Imrecv_pri(typename DATATYPE::PrimalType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Imrecv_pri(typename DATATYPE::PrimalType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(reverse_call);
-    MPI_Imrecv(bufAdjoints, bufSize, datatype->getADTool().getPrimalMpiType(), &message->message, &request->request);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Imrecv(bufAdjoints, bufType.count, bufType.type, &message->message, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Sendrecv_pri(typename SENDTYPE::PrimalType* sendbuf, int sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
-                         typename RECVTYPE::PrimalType* recvbuf, int recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
+  void AMPI_Sendrecv_pri(typename SENDTYPE::PrimalType* sendbuf, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
+                         typename RECVTYPE::PrimalType* recvbuf, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
 #endif
 
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
-    MPI_Sendrecv(sendbuf, sendbufSize, sendtype->getADTool().getPrimalMpiType(), dest, sendtag, recvbuf, recvbufSize, recvtype->getADTool().getPrimalMpiType(), source, recvtag, comm, status);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Sendrecv(sendbuf, sendbufType.count, sendbufType.type, dest, sendtag, recvbuf, recvbufType.count, recvbufType.type, source, recvtag, comm, status);
   }
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bcast_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
+  void AMPI_Sendrecv_replace_pri(typename DATATYPE::PrimalType* buf, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int sendtag, int source, int recvtag, AMPI_Comm comm, AMPI_Status* status) {
+    MEDI_UNUSED(count);
+    LargeCountType bufType(bufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Sendrecv_replace(buf, bufType.count, bufType.type, dest, sendtag, source, recvtag, comm, status);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Bcast_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
 
     if(root == getCommRank(comm)) {
       std::swap(sendbufAdjoints, recvbufAdjoints);
     }
-    MPI_Bcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), root, comm);
+    LargeCountType recvbufType(recvbufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Bcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibcast_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibcast_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
 
     if(root == getCommRank(comm)) {
       std::swap(sendbufAdjoints, recvbufAdjoints);
     }
-    MPI_Ibcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), root, comm, &request->request);
+    LargeCountType recvbufType(recvbufSize, datatype->getADTool().getPrimalMpiType());
+    MPI_Ibcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatter_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Scatter(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Scatter(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatter_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iscatter(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Iscatter(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatterv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Scatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm);
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Scatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatterv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iscatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm, &request->request);
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Iscatterv(sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Gather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Gather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Igather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Igather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Gatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), root, comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Gatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), root, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Igatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), root, comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Igatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), root, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Allgather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
+  void AMPI_Iallgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iallgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Iallgather(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Iallgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Iallgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Alltoall(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Ialltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LargeCountType recvbufType(recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Ialltoall(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufType.count, recvbufType.type, comm, &request->request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseSparse);
 
     MPI_Alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
   }
@@ -334,19 +382,128 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseSparse);
 
     MPI_Ialltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
   }
 #endif
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The received blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LinearDisplacements linDis(getCommInDegree(comm), recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, linDis.counts, linDis.displs, linDis.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The received blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    LinearDisplacements* linDis = new LinearDisplacements(getCommInDegree(comm), recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, linDis->counts, linDis->displs, linDis->type, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(reverseComm);
+
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(reverseComm);
+
+    LargeCountType sendbufType(sendbufSize, sendtype->getADTool().getPrimalMpiType());
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufType.count, sendbufType.type, recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    NeighborDisplacements linDis(comm, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    MPI_Neighbor_alltoallv(sendbufAdjoints, linDis.send.counts, linDis.send.displs, linDis.send.type, recvbufAdjoints, linDis.recv.counts, linDis.recv.displs, linDis.recv.type, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(reverseComm);
+
+    // The blocks are only stored for the neighbors that are not MPI_PROC_NULL.
+    NeighborDisplacements* linDis = new NeighborDisplacements(comm, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufSize, recvtype->getADTool().getPrimalMpiType());
+    request->setReverseData(reinterpret_cast<void*>(linDis), NeighborDisplacements::deleteFunc);
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, linDis->send.counts, linDis->send.displs, linDis->send.type, recvbufAdjoints, linDis->recv.counts, linDis->recv.displs, linDis->recv.type, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseComm);
+
+    MPI_Neighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+    MEDI_UNUSED(reverseComm);
+
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+  }
+#endif
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Reduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+  void AMPI_Reduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
     //TODO: MPI_Reduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), TODO, root, comm);
@@ -356,7 +513,7 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ireduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ireduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
     //TODO: MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), TODO, root, comm, &request->request);
@@ -364,9 +521,128 @@ namespace medi {
   }
 #endif
 
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  /**
+   * @brief Sum of the primal values of Reduce_scatter for primal types without an MPI sum operator.
+   *
+   * The blocks of all ranks for the own segment are received next to each other with an Alltoallv and summed into
+   * the receive buffer.
+   */
+  template<typename PrimalType>
+  struct ReduceScatterPrimalBlocks {
+      int* counts;
+      int* displs;
+      PrimalType* blocks;
+      PrimalType* recvbuf;
+      int elements;
+      int ranks;
+
+      /**
+       * @brief Create the buffer for the blocks of all ranks.
+       *
+       * @param[in] recvbuf  The receive buffer for the sum.
+       * @param[in] elements  The number of values of the own segment.
+       * @param[in]     comm  The communicator of the operation.
+       */
+      ReduceScatterPrimalBlocks(PrimalType* recvbuf, int elements, MPI_Comm comm) :
+        counts(nullptr),
+        displs(nullptr),
+        blocks(nullptr),
+        recvbuf(recvbuf),
+        elements(elements),
+        ranks(getCommSize(comm)) {
+        blocks = new PrimalType[(size_t)elements * ranks];
+        counts = new int[ranks];
+        displs = new int[ranks];
+        for(int i = 0; i < ranks; ++i) {
+          counts[i] = elements;
+          displs[i] = i * elements;
+        }
+      }
+
+      ~ReduceScatterPrimalBlocks() {
+        delete [] counts;
+        delete [] displs;
+        delete [] blocks;
+      }
+
+      /**
+       * @brief Sum the received blocks into the receive buffer.
+       */
+      void combine() {
+        for(int j = 0; j < elements; ++j) {
+          recvbuf[j] = blocks[j];
+        }
+        for(int i = 1; i < ranks; ++i) {
+          for(int j = 0; j < elements; ++j) {
+            recvbuf[j] += blocks[(size_t)i * elements + j];
+          }
+        }
+      }
+
+      /**
+       * @brief Completion function for the non-blocking operation, sums the blocks and deletes the structure.
+       *
+       * @param[in] d  The pointer to a ReduceScatterPrimalBlocks structure.
+       */
+      static void combineFunc(void* d) {
+        ReduceScatterPrimalBlocks* data = reinterpret_cast<ReduceScatterPrimalBlocks*>(d);
+
+        data->combine();
+        delete data;
+      }
+
+    private:
+      ReduceScatterPrimalBlocks(const ReduceScatterPrimalBlocks&) = delete;
+      ReduceScatterPrimalBlocks& operator=(const ReduceScatterPrimalBlocks&) = delete;
+  };
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(recvbufSize);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    // The wrappers only use Reduce_scatter_wrap for the sum.
+    MPI_Op sumOp = datatype->getADTool().getPrimalMpiSumOperator();
+    if(MPI_OP_NULL != sumOp) {
+      MPI_Reduce_scatter(sendbufAdjoints, recvbufAdjoints, sendbufCounts, datatype->getADTool().getPrimalMpiType(), sumOp, comm);
+    } else {
+      ReduceScatterPrimalBlocks<typename DATATYPE::PrimalType> blocks(recvbufAdjoints, sendbufCounts[getCommRank(comm)], comm);
+      MPI_Alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, datatype->getADTool().getPrimalMpiType(), blocks.blocks, blocks.counts, blocks.displs, datatype->getADTool().getPrimalMpiType(), comm);
+      blocks.combine();
+    }
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, const int* recvcounts, const int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(recvbufSize);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    // The wrappers only use Ireduce_scatter_wrap for the sum.
+    MPI_Op sumOp = datatype->getADTool().getPrimalMpiSumOperator();
+    if(MPI_OP_NULL != sumOp) {
+      MPI_Ireduce_scatter(sendbufAdjoints, recvbufAdjoints, sendbufCounts, datatype->getADTool().getPrimalMpiType(), sumOp, comm, &request->request);
+    } else {
+      // The blocks are summed when the request is completed in waitReverse.
+      using Blocks = ReduceScatterPrimalBlocks<typename DATATYPE::PrimalType>;
+      Blocks* blocks = new Blocks(recvbufAdjoints, sendbufCounts[getCommRank(comm)], comm);
+      request->setCompletionData(reinterpret_cast<void*>(blocks), Blocks::combineFunc);
+      MPI_Ialltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, datatype->getADTool().getPrimalMpiType(), blocks->blocks, blocks->counts, blocks->displs, datatype->getADTool().getPrimalMpiType(), comm, &request->request);
+    }
+  }
+#endif
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Allreduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+  void AMPI_Allreduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
 
@@ -377,7 +653,7 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Iallreduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallreduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
 
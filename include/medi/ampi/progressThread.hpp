@@ -0,0 +1,301 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include "../macros.h"
+
+#if MEDI_EnableProgressThread
+# include <atomic>
+# include <chrono>
+# include <mutex>
+# include <thread>
+#endif
+
+#include "async.hpp"
+#include "requestTable.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the request for the background progress thread.
+   *
+   * If enabled, AMPI_Init_thread starts a thread that drives the MPI progress while the application computes. The
+   * thread is only started if MPI provides MPI_THREAD_MULTIPLE. It is stopped at the beginning of MPI_Finalize.
+   *
+   * The thread also performs the completion actions of the reverse communication of non-blocking operations that
+   * convert adjoint buffers, e.g. for a reduced transport precision, see AdjointTransport. These actions only touch
+   * buffers of MeDiPack and are performed as soon as the communication has finished. The continuation functions of
+   * the requests in the forward evaluation modify user buffers and the tape, they are still performed in AMPI_Wait
+   * and AMPI_Test.
+   *
+   * The thread is only available if MeDiPack is compiled with MEDI_EnableProgressThread=true.
+   *
+   * @return Reference to the flag.
+   */
+  inline bool& progressThreadEnabled() {
+    static bool enabled = false;
+
+    return enabled;
+  }
+
+  /**
+   * @brief Enable or disable the background progress thread, see progressThreadEnabled.
+   *
+   * Needs to be called before AMPI_Init_thread.
+   *
+   * @param[in] enabled  True if AMPI_Init_thread starts the progress thread.
+   */
+  inline void setProgressThread(bool enabled) {
+#if !MEDI_EnableProgressThread
+    if(enabled) {
+      MEDI_EXCEPTION("The progress thread requires MeDiPack to be compiled with MEDI_EnableProgressThread=true.");
+    }
+#endif
+    progressThreadEnabled() = enabled;
+  }
+
+  /**
+   * @brief Access to the time between two polls of the progress thread.
+   * @return Reference to the interval in microseconds.
+   */
+  inline int& progressThreadInterval() {
+    static int interval = 100;
+
+    return interval;
+  }
+
+  /**
+   * @brief Set the time between two polls of the progress thread.
+   * @param[in] interval  The interval in microseconds.
+   */
+  inline void setProgressThreadInterval(int interval) {
+    mediAssert(0 <= interval);
+    progressThreadInterval() = interval;
+  }
+
+#if MEDI_EnableProgressThread
+  /**
+   * @brief Thread that polls MPI and the reverse requests with completion actions.
+   *
+   * The MPI progress is driven by probing a private communicator. The reverse requests are checked with
+   * MPI_Request_get_status, which does not free the request. Their completion action is performed by the thread once
+   * the communication has finished. The request is still completed with waitReverse, which removes it from the thread
+   * first.
+   *
+   * The thread keeps copies of the MPI requests in a RequestTable, the polling does not access the AMPI_Request
+   * structures of the pending requests.
+   */
+  struct ProgressEngine {
+      std::thread thread;
+      std::mutex mutex;
+      std::atomic<bool> running;
+      RequestTable<AMPI_Request*> requests;
+      MPI_Comm probeComm;
+
+      ProgressEngine() :
+        thread(),
+        mutex(),
+        running(false),
+        requests(),
+        probeComm(MPI_COMM_NULL) {}
+
+      ~ProgressEngine() {
+        if(thread.joinable()) {
+          running = false;
+          thread.join();
+        }
+      }
+
+      bool isRunning() const {
+        return running;
+      }
+
+      /**
+       * @brief Start the thread, MPI needs to provide MPI_THREAD_MULTIPLE.
+       *
+       * An attribute is set on MPI_COMM_SELF, its delete function stops the thread at the beginning of MPI_Finalize.
+       */
+      void start() {
+        MPI_Comm_dup(MPI_COMM_SELF, &probeComm);
+
+        int keyval;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, finalizeFunc, &keyval, nullptr);
+        MPI_Comm_set_attr(MPI_COMM_SELF, keyval, reinterpret_cast<void*>(this));
+        MPI_Comm_free_keyval(&keyval);
+
+        running = true;
+        thread = std::thread(&ProgressEngine::run, this);
+      }
+
+      /**
+       * @brief Stop the thread and perform the remaining completion actions.
+       */
+      void stop() {
+        running = false;
+        thread.join();
+
+        for(AMPI_Request* request : requests.data) {
+          MPI_Wait(&request->request, MPI_STATUS_IGNORE);
+          request->performCompletionAction();
+        }
+        requests.clear();
+
+        MPI_Comm_free(&probeComm);
+      }
+
+      /**
+       * @brief Let the thread perform the completion action of a reverse request.
+       *
+       * The request has to stay valid until it is completed with waitReverse.
+       *
+       * @param[in,out] request  The request with the completion data.
+       */
+      void add(AMPI_Request* request) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int index = requests.add(request);
+        requests.requests[index] = request->request;
+      }
+
+      /**
+       * @brief Remove a request from the thread, its completion action is then performed by the caller.
+       *
+       * If the thread has already performed the action, the completion data of the request is reset.
+       *
+       * @param[in,out] request  The request, it may not be known to the thread.
+       */
+      void remove(AMPI_Request* request) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int index = requests.find(request);
+        if(-1 != index) {
+          requests.remove(index);
+        }
+      }
+
+    private:
+
+      void run() {
+        while(running) {
+          poll();
+
+          int flag;
+          MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, probeComm, &flag, MPI_STATUS_IGNORE);
+
+          std::this_thread::sleep_for(std::chrono::microseconds(progressThreadInterval()));
+        }
+      }
+
+      void poll() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        int pos = 0;
+        while(pos < requests.size()) {
+          int flag = 0;
+          MPI_Request_get_status(requests.requests[pos], &flag, MPI_STATUS_IGNORE);
+          if(flag) {
+            requests.data[pos]->performCompletionAction();
+            requests.remove(pos);
+          } else {
+            pos += 1;
+          }
+        }
+      }
+
+      static int finalizeFunc(MPI_Comm comm, int keyval, void* attribute, void* extraState) {
+        MEDI_UNUSED(comm);
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        reinterpret_cast<ProgressEngine*>(attribute)->stop();
+
+        return MPI_SUCCESS;
+      }
+  };
+
+  /**
+   * @brief Access to the background progress thread.
+   * @return The global progress engine.
+   */
+  inline ProgressEngine& getProgressEngine() {
+    static ProgressEngine engine;
+
+    return engine;
+  }
+#endif
+
+  /**
+   * @brief Start the progress thread if it is enabled and MPI supports it, see progressThreadEnabled.
+   * @param[in] provided  The thread level that is provided by MPI.
+   */
+  inline void startProgressThread(int provided) {
+#if MEDI_EnableProgressThread
+    if(progressThreadEnabled() && MPI_THREAD_MULTIPLE == provided && !getProgressEngine().isRunning()) {
+      getProgressEngine().start();
+    }
+#else
+    MEDI_UNUSED(provided);
+#endif
+  }
+
+  /**
+   * @brief Hand the completion action of a reverse request to the progress thread, if it is running.
+   * @param[in,out] request  The request with the completion data, it has to stay valid until waitReverse.
+   */
+  inline void addReverseCompletion(AMPI_Request* request) {
+#if MEDI_EnableProgressThread
+    if(getProgressEngine().isRunning()) {
+      getProgressEngine().add(request);
+    }
+#else
+    MEDI_UNUSED(request);
+#endif
+  }
+
+  /**
+   * @brief Wait for the communication of a reverse request and perform its completion action.
+   *
+   * If the progress thread has already performed the completion action, only the request is completed. The data
+   * that the communication has attached to the request is deleted afterwards.
+   *
+   * @param[in,out] request  The request of the reverse communication.
+   */
+  inline void waitReverse(AMPI_Request* request) {
+#if MEDI_EnableProgressThread
+    if(getProgressEngine().isRunning()) {
+      getProgressEngine().remove(request);
+    }
+#endif
+    MPI_Wait(&request->request, MPI_STATUS_IGNORE);
+    request->performCompletionAction();
+    request->deleteReverseData();
+  }
+}
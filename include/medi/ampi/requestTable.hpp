@@ -0,0 +1,137 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Table of MPI requests with data of MeDiPack for each request.
+   *
+   * The requests are stored contiguously and the data in a separate array, both are addressed by the same index. The
+   * request array can be given directly to the MPI calls for multiple requests and polling the requests only touches
+   * the request array.
+   *
+   * Entries are removed by moving the last entry into their place, the order of the entries is not kept. Moving the
+   * data needs to keep buffers that are used by MPI at their location, e.g. std::vector moves its storage.
+   *
+   * The table is used for the request sets that MeDiPack manages itself, i.e. the requests of the progress thread and
+   * the pending reverse sends. The request arrays of the user are arrays of AMPI_Request and are still converted for
+   * each multi-request call, see convertToMPI.
+   *
+   * @tparam Data  The data that is stored for each request.
+   */
+  template<typename Data>
+  struct RequestTable {
+      std::vector<MPI_Request> requests;
+      std::vector<Data> data;
+
+      RequestTable() :
+        requests(),
+        data() {}
+
+      int size() const {
+        return (int)requests.size();
+      }
+
+      bool empty() const {
+        return requests.empty();
+      }
+
+      /**
+       * @brief Add an entry with a null request, the request is set by the caller, e.g. with a non-blocking MPI call.
+       *
+       * @param[in] entryData  The data of the entry.
+       * @return The index of the new entry.
+       */
+      int add(Data entryData) {
+        requests.push_back(MPI_REQUEST_NULL);
+        data.push_back(std::move(entryData));
+
+        return size() - 1;
+      }
+
+      /**
+       * @brief Remove an entry, the last entry is moved to its index.
+       * @param[in] index  The index of the entry.
+       */
+      void remove(int index) {
+        int last = size() - 1;
+        if(index != last) {
+          requests[index] = requests[last];
+          data[index] = std::move(data[last]);
+        }
+        requests.pop_back();
+        data.pop_back();
+      }
+
+      /**
+       * @brief Remove several entries.
+       *
+       * @param[in,out] indices  The indices of the entries, they are sorted by the call.
+       * @param[in]       count  The number of indices.
+       */
+      void remove(int* indices, int count) {
+        std::sort(indices, indices + count);
+
+        // Remove from the back, the entries that are moved forward are not in the list.
+        for(int i = count - 1; i >= 0; --i) {
+          remove(indices[i]);
+        }
+      }
+
+      /**
+       * @brief Find the first entry with the given data.
+       * @param[in] entryData  The data of the entry.
+       * @return The index of the entry or -1 if it is not in the table.
+       */
+      int find(const Data& entryData) const {
+        typename std::vector<Data>::const_iterator pos = std::find(data.begin(), data.end(), entryData);
+        if(data.end() == pos) {
+          return -1;
+        } else {
+          return (int)(pos - data.begin());
+        }
+      }
+
+      void clear() {
+        requests.clear();
+        data.clear();
+      }
+  };
+}
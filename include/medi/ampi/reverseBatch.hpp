@@ -0,0 +1,79 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <algorithm>
+
+#include "reversePrefetch.hpp"
+#include "reverseSendWindow.hpp"
+#include "../adjointInterface.hpp"
+#include "../typeDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Evaluate adjacent handles of the reverse sweep with overlapping communication.
+   *
+   * The AD tool can call this function instead of the reverse functions of the handles, e.g. for the face exchanges of
+   * a halo update. First, the adjoint receives of all handles are posted in evaluation order, see prefetchReverse.
+   * Then the reverse functions are called in the given order, the adjoint sends of blocking receives are non-blocking
+   * during the batch, see reverseSendWindow. No handle waits on the handshake of a previous handle, the adjoints are
+   * still extracted and updated in the sequential order. The results are therefore identical to the sequential
+   * evaluation, also for dependent handles.
+   *
+   * The adjoint sends of the batch are completed at the end, unless the reverse send window allows them to stay in
+   * flight.
+   *
+   * @param[in,out]          handles  The handles in the order of the reverse evaluation.
+   * @param[in]              count  The number of handles.
+   * @param[in]   adjointInterface  The interface of the AD tool for the reverse evaluation.
+   */
+  inline void evaluateReverseBatch(HandleBase** handles, int count, AdjointInterface* adjointInterface) {
+    for(int i = 0; i < count; ++i) {
+      if(!prefetchReverse(handles[i], adjointInterface)) {
+        break;
+      }
+    }
+
+    PendingReverseSends& pending = getPendingReverseSends();
+    int minWindow = pending.minWindow;
+    pending.minWindow = std::max(minWindow, count);
+
+    for(int i = 0; i < count; ++i) {
+      handles[i]->funcReverse(handles[i], adjointInterface);
+    }
+
+    pending.minWindow = minWindow;
+    pending.retire();
+  }
+}
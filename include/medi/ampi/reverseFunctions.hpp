@@ -28,128 +28,399 @@
 
 #pragma once
 
+#include "adjointTransport.hpp"
 #include "ampiMisc.h"
 #include "async.hpp"
+#include "chunkedReverse.hpp"
+#include "coalescing.hpp"
 #include "enums.hpp"
+#include "hierarchicalReverse.hpp"
 #include "message.hpp"
+#include "reverseSendWindow.hpp"
+#include "shadowComm.hpp"
 #include "../displacementTools.hpp"
+#include "../mpiTools.h"
 
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
  */
 namespace medi {
 
+  /**
+   * @brief Check if the adjoints of a gather to all ranks are summed by MPI.
+   *
+   * The predefined operators can not be used with the derived datatypes for large counts, the adjoints are then
+   * received rank by rank.
+   *
+   * @param[in] adType  The AD tool of the communicated type.
+   * @param[in]  count  The largest number of adjoint values one rank receives in the reduction.
+   * @return True if the reduction is done with the sum operator of the AD tool.
+   */
+  inline bool isAdjointSumReduction(ADToolInterface const* adType, LargeCount count) {
+    return MPI_OP_NULL != adType->getAdjointMpiSumOperator() && !isLargeCount(count);
+  }
+
+  /**
+   * @brief Number of rank blocks that are received in the reverse of a gather to all ranks.
+   *
+   * If the AD tool provides a sum operator for the adjoint type, the adjoints of all ranks are summed by MPI and only
+   * one block is received. Otherwise one block is received from each rank and the blocks are combined with
+   * AdjointInterface::combineAdjoints.
+   *
+   * @param[in] adType  The AD tool of the communicated type.
+   * @param[in]  count  The largest number of adjoint values one rank receives in the reduction.
+   * @param[in]   comm  The communicator of the operation.
+   * @return The number of blocks the adjoint buffer needs to hold.
+   */
+  inline int getAdjointRankBlocks(ADToolInterface const* adType, LargeCount count, MPI_Comm comm) {
+    if(isAdjointSumReduction(adType, count)) {
+      return 1;
+    } else {
+      return getCommSize(comm);
+    }
+  }
+
+  /**
+   * @brief Access to the switch for the sparse reverse of Alltoallv.
+   *
+   * If enabled, the reverse of Alltoallv and Ialltoallv is performed with point-to-point communication. Each rank
+   * only posts the messages for its own non-zero counts, the decision therefore requires no communication. It pays
+   * off if most of the counts are zero, e.g. if each rank exchanges data with a few other ranks.
+   *
+   * The decision is made when the call is recorded, the value needs to be the same on all ranks at this point.
+   * The default is false.
+   *
+   * @return Reference to the switch.
+   */
+  inline bool& alltoallvSparseReverse() {
+    static bool enabled = false;
+
+    return enabled;
+  }
+
+  /**
+   * @brief Enable or disable the sparse reverse of Alltoallv.
+   * @param[in] enabled  True if the reverse should use point-to-point communication.
+   */
+  inline void setAlltoallvSparseReverse(bool enabled) {
+    alltoallvSparseReverse() = enabled;
+  }
+
+  /**
+   * @brief The key for the communicator of the sparse reverse of Alltoallv.
+   * @return The keyval, it is created on the first call.
+   */
+  inline int getSparseAlltoallvCommKeyval() {
+    static int keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, deleteShadowComm);
+
+    return keyval;
+  }
+
+  /**
+   * @brief Get the communicator for the point-to-point messages of the sparse reverse of Alltoallv.
+   *
+   * The messages are exchanged on a duplicate of the shadow communicator, they can therefore not match any other
+   * adjoint message. The duplicate is cached as an attribute of the user communicator. The call is collective over
+   * the communicator if the duplicate does not exist.
+   *
+   * @param[in] comm  The user communicator.
+   * @return The communicator for the sparse exchange.
+   */
+  inline MPI_Comm getSparseAlltoallvComm(MPI_Comm comm) {
+    MPI_Comm* sparseComm;
+    int flag;
+    MPI_Comm_get_attr(comm, getSparseAlltoallvCommKeyval(), &sparseComm, &flag);
+    if(!flag) {
+      sparseComm = new MPI_Comm;
+      MPI_Comm_dup(getShadowComm(comm), sparseComm);
+      MPI_Comm_set_attr(comm, getSparseAlltoallvCommKeyval(), sparseComm);
+    }
+
+    return *sparseComm;
+  }
+
+  /**
+   * @brief Check if the reverse of an Alltoallv uses point-to-point communication, see alltoallvSparseReverse.
+   *
+   * Called when the Alltoallv is recorded, the result is stored in the handle. The communicator for the messages is
+   * created on the first sparse call on a communicator, only this call is collective.
+   *
+   * @param[in] comm  The user communicator of the Alltoallv.
+   * @return True if the point-to-point exchange should be used.
+   */
+  inline bool isSparseAlltoallv(MPI_Comm comm) {
+    bool sparse = alltoallvSparseReverse();
+    if(sparse) {
+      getSparseAlltoallvComm(comm);
+    }
+
+    return sparse;
+  }
+
+  /**
+   * @brief Post the messages of an Alltoallv exchange to the ranks that have non-zero counts.
+   *
+   * The arguments are the same as for MPI_Ialltoallv. The messages are sent with tag zero, the communicator needs to
+   * be the one from getSparseAlltoallvComm.
+   *
+   * @param[out] requests  The requests of the posted messages are appended.
+   */
+  inline void postSparseAlltoallv(void* sendbuf, const int* sendcounts, const int* sdispls, MPI_Datatype sendtype,
+                                  void* recvbuf, const int* recvcounts, const int* rdispls, MPI_Datatype recvtype,
+                                  MPI_Comm comm, std::vector<MPI_Request>& requests) {
+    int ranks = getCommSize(comm);
+
+    for(int i = 0; i < ranks; ++i) {
+      if(0 != recvcounts[i]) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Irecv(shiftBuffer(recvbuf, rdispls[i], recvtype), recvcounts[i], recvtype, i, 0, comm, &requests.back());
+      }
+    }
+    for(int i = 0; i < ranks; ++i) {
+      if(0 != sendcounts[i]) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(shiftBuffer(sendbuf, sdispls[i], sendtype), sendcounts[i], sendtype, i, 0, comm, &requests.back());
+      }
+    }
+  }
+
+  /**
+   * @brief Alltoallv exchange that only communicates with the ranks that have non-zero counts.
+   *
+   * The arguments are the same as for MPI_Alltoallv, see postSparseAlltoallv.
+   */
+  inline void sparseAlltoallv(void* sendbuf, const int* sendcounts, const int* sdispls, MPI_Datatype sendtype,
+                              void* recvbuf, const int* recvcounts, const int* rdispls, MPI_Datatype recvtype,
+                              MPI_Comm comm) {
+    std::vector<MPI_Request> requests;
+    postSparseAlltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm, requests);
+
+    MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  /**
+   * @brief The messages of a non-blocking sparse Alltoallv exchange in the reverse evaluation.
+   *
+   * The object takes over the adjoint transport of the exchange, the buffers are converted back after all messages
+   * have been completed.
+   */
+  struct SparseAlltoallvMessages {
+      std::vector<MPI_Request> requests;
+      AdjointTransport transport;
+
+      explicit SparseAlltoallvMessages(AdjointTransport&& transport) :
+        requests(),
+        transport(std::move(transport)) {}
+
+      /**
+       * @brief Complete the messages when the request is completed in the reverse evaluation.
+       *
+       * The object needs to be created with new, it is deleted in the completion action of the request.
+       *
+       * @param[in,out] request  The request of the non-blocking reverse communication.
+       */
+      void finish(AMPI_Request* request) {
+        request->request = MPI_REQUEST_NULL;
+        request->setCompletionData(reinterpret_cast<void*>(this), SparseAlltoallvMessages::finishFunc);
+      }
+
+      /**
+       * @brief Completion function for requests, see finish(AMPI_Request*).
+       */
+      static void finishFunc(void* data) {
+        SparseAlltoallvMessages* messages = reinterpret_cast<SparseAlltoallvMessages*>(data);
+        MPI_Waitall((int)messages->requests.size(), messages->requests.data(), MPI_STATUSES_IGNORE);
+        messages->transport.finish();
+
+        delete messages;
+      }
+  };
+
+  /**
+   * @brief Receive the adjoints in the reverse of a blocking send.
+   *
+   * Used for all send modes. The message is added to an active coalescing region, split into chunks if it is large
+   * and otherwise received with MPI_Recv through the adjoint transport.
+   *
+   * @param[in,out] bufAdjoints  The adjoints of the send buffer.
+   * @param[in]         bufSize  The number of adjoint values.
+   * @param[in]        datatype  The datatype of the send.
+   * @param[in]             src  The destination of the send.
+   * @param[in]             tag  The tag of the send.
+   * @param[in]            comm  The communicator of the send.
+   */
+  template<typename DATATYPE>
+  void recvAdjoints(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, DATATYPE* datatype, int src, int tag, AMPI_Comm comm) {
+    ReverseCoalescingState* coalescing = getActiveReverseCoalescingState(comm);
+    if(nullptr != coalescing) {
+      coalescing->get(src, tag, bufAdjoints, computeAdjointBytes(bufSize, datatype->getADTool().getAdjointMpiType()), getShadowComm(comm));
+    } else if(isReverseChunked(bufSize)) {
+      ChunkedAdjointMessages chunks;
+      chunks.recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+      chunks.wait();
+    } else {
+      AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage message = transport.recvMessage(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType());
+      LargeCountType bufType(message.count, message.type);
+      MPI_Recv(message.buf, bufType.count, bufType.type, src, tag, getShadowComm(comm), MPI_STATUS_IGNORE);
+      transport.finish();
+    }
+  }
+
+  /**
+   * @brief Receive the adjoints in the reverse of a non-blocking send.
+   *
+   * Used for all send modes. Large messages are split into chunks, all others are received with MPI_Irecv through
+   * the adjoint transport.
+   *
+   * @param[in,out] bufAdjoints  The adjoints of the send buffer.
+   * @param[in]         bufSize  The number of adjoint values.
+   * @param[in]        datatype  The datatype of the send.
+   * @param[in]             src  The destination of the send.
+   * @param[in]             tag  The tag of the send.
+   * @param[in]            comm  The communicator of the send.
+   * @param[out]        request  The request of the reverse communication.
+   * @param[in]        sendName  The name of the send for the error in a coalescing region.
+   */
+  template<typename DATATYPE>
+  void irecvAdjoints(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, const char* sendName) {
+    if(nullptr != getActiveReverseCoalescingState(comm)) {
+      MEDI_EXCEPTION("%s is not supported in a region with reverse coalescing.", sendName);
+    }
+    if(isReverseChunked(bufSize)) {
+      ChunkedAdjointMessages* chunks = new ChunkedAdjointMessages();
+      chunks->recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+      chunks->finish(request);
+    } else {
+      AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage message = transport.recvMessage(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType());
+      LargeCountType bufType(message.count, message.type);
+      MPI_Irecv(message.buf, bufType.count, bufType.type, src, tag, getShadowComm(comm), &request->request);
+      transport.finish(request);
+    }
+  }
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Send_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Send_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Isend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Isend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm, request, "Isend");
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Bsend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibsend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm, request, "Ibsend");
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ssend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Ssend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Issend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Issend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm, request, "Issend");
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Rsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
+  void AMPI_Rsend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Irsend_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype, dest, tag, comm, request, "Irsend");
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Recv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Recv_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status, RecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(status);
-    if (RecvAdjCall::Send == reverse_call) {
-      MPI_Send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
-    } else if (RecvAdjCall::Bsend == reverse_call) {
-      MPI_Bsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
-    } else if (RecvAdjCall::Rsend == reverse_call) {
-      MPI_Rsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
-    } else if (RecvAdjCall::Ssend == reverse_call) {
-      MPI_Ssend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+    ReverseCoalescingState* coalescing = getActiveReverseCoalescingState(comm);
+    if(nullptr != coalescing) {
+      coalescing->add(src, tag, bufAdjoints, computeAdjointBytes(bufSize, datatype->getADTool().getAdjointMpiType()));
+    } else if(isReverseChunked(bufSize)) {
+      ChunkedAdjointMessages chunks;
+      chunks.send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+      chunks.wait();
+    } else if(isWindowedReverseSend(reverse_call)) {
+      AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage message = transport.sendMessage(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType());
+      getPendingReverseSends().post(message, reverse_call, src, tag, getShadowComm(comm));
+      transport.finish();
     } else {
-      MEDI_EXCEPTION("Unimplemented case for RecvAdjCall %d.", (int)reverse_call);
+      AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage message = transport.sendMessage(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType());
+      sendAdjointMessage(message, reverse_call, src, tag, getShadowComm(comm));
+      transport.finish();
     }
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Mrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
+  void AMPI_Mrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status, RecvAdjCall reverse_call) {
     AMPI_Recv_adj(bufAdjoints, bufSize, count, datatype, message->src, message->tag, message->comm, status, reverse_call);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Irecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Irecv_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
-    if (IrecvAdjCall::Isend == reverse_call) {
-      MPI_Isend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
-    } else if (IrecvAdjCall::Ibsend == reverse_call) {
-      MPI_Ibsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
-    } else if (IrecvAdjCall::Irsend == reverse_call) {
-      MPI_Irsend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
-    } else if (IrecvAdjCall::Issend == reverse_call) {
-      MPI_Issend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
+    ReverseCoalescingState* coalescing = getActiveReverseCoalescingState(comm);
+    if(nullptr != coalescing) {
+      coalescing->add(src, tag, bufAdjoints, computeAdjointBytes(bufSize, datatype->getADTool().getAdjointMpiType()));
+      request->request = MPI_REQUEST_NULL;
+    } else if(isReverseChunked(bufSize)) {
+      ChunkedAdjointMessages* chunks = new ChunkedAdjointMessages();
+      chunks->send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+      chunks->finish(request);
     } else {
-      MEDI_EXCEPTION("Unimplemented case for IrecvAdjCall %d.", (int)reverse_call);
+      AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage message = transport.sendMessage(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType());
+      isendAdjointMessage(message, reverse_call, src, tag, getShadowComm(comm), &request->request);
+      transport.finish(request);
     }
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Imrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
+  void AMPI_Imrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, LargeCount bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request, IrecvAdjCall reverse_call) {
     MEDI_UNUSED(count);
     AMPI_Irecv_adj(bufAdjoints, bufSize, count, datatype, message->src, message->tag, message->comm, request, reverse_call);
   }
@@ -157,249 +428,670 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Sendrecv_adj(typename SENDTYPE::AdjointType* sendbuf, int sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
+  void AMPI_Sendrecv_adj(typename SENDTYPE::AdjointType* sendbuf, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, int dest, int sendtag,
 #endif
-                     typename RECVTYPE::AdjointType* recvbuf, int recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
-
+                     typename RECVTYPE::AdjointType* recvbuf, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status*  status) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
-    MPI_Sendrecv(recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType(), source, recvtag, sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType(), dest, sendtag, comm, status);
+    if(isReverseChunked(sendbufSize) || isReverseChunked(recvbufSize)) {
+      ChunkedAdjointMessages chunks;
+      chunks.send(recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType(), source, recvtag, comm);
+      chunks.recv(sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType(), dest, sendtag, comm);
+      chunks.wait();
+    } else {
+      // The messages of both directions are encoded separately.
+      AdjointTransport sendTransport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+      AdjointTransport recvTransport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+      AdjointMessage sendMessage = sendTransport.sendMessage(recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType());
+      AdjointMessage recvMessage = recvTransport.recvMessage(sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType());
+      LargeCountType recvbufType(sendMessage.count, sendMessage.type);
+      LargeCountType sendbufType(recvMessage.count, recvMessage.type);
+      MPI_Sendrecv(sendMessage.buf, recvbufType.count, recvbufType.type, source, recvtag, recvMessage.buf, sendbufType.count, sendbufType.type, dest, sendtag, getShadowComm(comm), status);
+      sendTransport.finish();
+      recvTransport.finish();
+    }
+  }
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Sendrecv_replace_adj(typename DATATYPE::AdjointType* buf, LargeCount bufSize, int count, DATATYPE* datatype, int dest, int sendtag, int source, int recvtag, AMPI_Comm comm, AMPI_Status* status) {
+    MEDI_UNUSED(count);
+    if(isReverseChunked(bufSize)) {
+      chunkedSendrecvReplace(buf, bufSize, datatype->getADTool().getAdjointMpiType(), dest, sendtag, source, recvtag, comm);
+    } else {
+      AdjointTransport sendTransport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointTransport recvTransport(comm, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage sendMessage = sendTransport.sendMessage(buf, bufSize, datatype->getADTool().getAdjointMpiType());
+      AdjointMessage recvMessage = recvTransport.recvMessage(buf, bufSize, datatype->getADTool().getAdjointMpiType());
+      LargeCountType sendType(sendMessage.count, sendMessage.type);
+      if(sendMessage.buf == recvMessage.buf) {
+        MPI_Sendrecv_replace(buf, sendType.count, sendType.type, source, recvtag, dest, sendtag, getShadowComm(comm), status);
+      } else {
+        // Encoded messages use separate buffers.
+        LargeCountType recvType(recvMessage.count, recvMessage.type);
+        MPI_Sendrecv(sendMessage.buf, sendType.count, sendType.type, source, recvtag, recvMessage.buf, recvType.count, recvType.type, dest, sendtag, getShadowComm(comm), status);
+      }
+      // The received values replace the sent ones, only the receive side is converted back.
+      recvTransport.finish();
+    }
   }
+#endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Bcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
+  void AMPI_Bcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
 
-    MPI_Gather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    if(isHierarchicalReverse(adType)) {
+      hierarchicalAdjointSum(recvbufAdjoints, sendbufAdjoints, recvbufSize, adType->getAdjointMpiType(), adType->getAdjointMpiSumOperator(), root, comm);
+      return;
+    }
+#endif
+
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Gather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ibcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ibcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
 
-    MPI_Igather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Igather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatter_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Gather(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Gather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatter_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Igather(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Igather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Scatterv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Gatherv(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getAdjointMpiType(), root, comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispl, getCommSize(comm), sendbufVectorSize);
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Gatherv(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispl, sendbufType.type, root, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iscatterv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispl, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcount, MEDI_OPTIONAL_CONST int* displs, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Igatherv(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispl, sendtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    if(root == getCommRank(comm)) {
+      transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispl, getCommSize(comm), sendbufVectorSize);
+    }
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Igatherv(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispl, sendbufType.type, root, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Scatter(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    if(root == getCommRank(comm)) {
+      transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    }
+    transport.recv(sendbufAdjoints, sendbufSize);
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Scatter(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Iscatter(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    if(root == getCommRank(comm)) {
+      transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    }
+    transport.recv(sendbufAdjoints, sendbufSize);
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Iscatter(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Gatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  void AMPI_Gatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Scatterv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    if(root == getCommRank(comm)) {
+      transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    }
+    transport.recv(sendbufAdjoints, sendbufSize);
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Scatterv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Igatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Igatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    MPI_Iscatterv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    if(root == getCommRank(comm)) {
+      transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    }
+    transport.recv(sendbufAdjoints, sendbufSize);
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Iscatterv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    if(isAdjointSumReduction(adType, sendbufSize)) {
+      transport.recv(sendbufAdjoints, sendbufSize);
+      MPI_Reduce_scatter_block(recvbufAdjoints, sendbufAdjoints, (int)sendbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()), adType->getAdjointMpiSumOperator(), getShadowComm(comm));
+    } else {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+      LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+      LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+      MPI_Alltoall(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm));
+    }
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
+  void AMPI_Iallgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request ) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Ialltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    if(isAdjointSumReduction(adType, sendbufSize)) {
+      transport.recv(sendbufAdjoints, sendbufSize);
+      MPI_Ireduce_scatter_block(recvbufAdjoints, sendbufAdjoints, (int)sendbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()), adType->getAdjointMpiSumOperator(), getShadowComm(comm), &request->request);
+    } else {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+      LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+      LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+      MPI_Ialltoall(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm), &request->request);
+    }
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    LinearDisplacements linDis(getCommSize(comm), sendbufSize);
-
-    MPI_Alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis.counts, linDis.displs, sendtype->getADTool().getAdjointMpiType(), comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    if(isAdjointSumReduction(adType, (LargeCount)recvbufVectorSize * computeMaxCount(recvbufCounts, getCommSize(comm)))) {
+      transport.recv(sendbufAdjoints, sendbufSize);
+      // The adjoint displacements are linear, the counts are therefore sufficient for the reduction.
+      ScaledCounts scaled(recvbufCounts, getCommSize(comm), recvbufVectorSize);
+      MPI_Reduce_scatter(recvbufAdjoints, sendbufAdjoints, scaled.counts, transport.wireType(recvtype->getADTool().getAdjointMpiType()), adType->getAdjointMpiSumOperator(), getShadowComm(comm));
+    } else {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+      LinearDisplacements linDis(getCommSize(comm), sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+      VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+      MPI_Alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, linDis.counts, linDis.displs, linDis.type, getShadowComm(comm));
+    }
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iallgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(displs);
 
-    LinearDisplacements* linDis = new LinearDisplacements(getCommSize(comm), sendbufSize);
-    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
-
-    MPI_Ialltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis->counts, linDis->displs, sendtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    if(isAdjointSumReduction(adType, (LargeCount)recvbufVectorSize * computeMaxCount(recvbufCounts, getCommSize(comm)))) {
+      transport.recv(sendbufAdjoints, sendbufSize);
+      // The adjoint displacements are linear, the counts are therefore sufficient for the reduction.
+      ScaledCounts* scaled = new ScaledCounts(recvbufCounts, getCommSize(comm), recvbufVectorSize);
+      request->setReverseData(reinterpret_cast<void*>(scaled), ScaledCounts::deleteFunc);
+      MPI_Ireduce_scatter(recvbufAdjoints, sendbufAdjoints, scaled->counts, transport.wireType(recvtype->getADTool().getAdjointMpiType()), adType->getAdjointMpiSumOperator(), getShadowComm(comm), &request->request);
+    } else {
+      transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+      LinearDisplacements* linDis = new LinearDisplacements(getCommSize(comm), sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+      request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+      VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+      MPI_Ialltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, linDis->counts, linDis->displs, linDis->type, getShadowComm(comm), &request->request);
+    }
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Alltoall(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
 
-    MPI_Ialltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommSize(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    LargeCountType recvbufType(recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    MPI_Ialltoall(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+  void AMPI_Alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
 
-    MPI_Alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), comm);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommSize(comm), sendbufVectorSize);
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    int elementBytes = getSparseEncodingElementBytes(recvbufType.type);
+    if(0 != elementBytes) {
+      encodedAlltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, sendbufAdjoints, sendbufCounts, sendbufDispls, elementBytes, getShadowComm(comm));
+    } else if(reverseSparse) {
+      sparseAlltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getSparseAlltoallvComm(comm));
+    } else {
+      MPI_Alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getShadowComm(comm));
+    }
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Ialltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ialltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, bool reverseSparse) {
     MEDI_UNUSED(sendcounts);
     MEDI_UNUSED(sdispls);
     MEDI_UNUSED(recvcounts);
     MEDI_UNUSED(rdispls);
 
-    MPI_Ialltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), comm, &request->request);
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommSize(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommSize(comm), sendbufVectorSize);
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    if(reverseSparse) {
+      SparseAlltoallvMessages* messages = new SparseAlltoallvMessages(std::move(transport));
+      postSparseAlltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getSparseAlltoallvComm(comm), messages->requests);
+      messages->finish(request);
+    } else {
+      MPI_Ialltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getShadowComm(comm), &request->request);
+      transport.finish(request);
+    }
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // Every destination returns the adjoint of its copy, the copies are combined afterwards. The neighbors that
+    // are MPI_PROC_NULL have no blocks.
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommConnectedInDegree(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    NeighborDisplacements linDis(comm, sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Neighbor_alltoallv(recvbufAdjoints, linDis.recv.counts, linDis.recv.displs, linDis.recv.type, sendbufAdjoints, linDis.send.counts, linDis.send.displs, linDis.send.type, reverseComm);
+    transport.finish();
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // Every destination returns the adjoint of its copy, the copies are combined afterwards. The neighbors that
+    // are MPI_PROC_NULL have no blocks.
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommConnectedInDegree(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    NeighborDisplacements* linDis = new NeighborDisplacements(comm, sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    request->setReverseData(reinterpret_cast<void*>(linDis), NeighborDisplacements::deleteFunc);
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, linDis->recv.counts, linDis->recv.displs, linDis->recv.type, sendbufAdjoints, linDis->send.counts, linDis->send.displs, linDis->send.type, reverseComm, &request->request);
+    transport.finish(request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    LinearDisplacements linDis(getCommOutDegree(comm), sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), comm);
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommInDegree(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Neighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, linDis.counts, linDis.displs, linDis.type, reverseComm);
+    transport.finish();
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    LinearDisplacements* linDis = new LinearDisplacements(getCommOutDegree(comm), sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), comm);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommInDegree(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, linDis->counts, linDis->displs, linDis->type, reverseComm, &request->request);
+    transport.finish(request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // The neighbors that are MPI_PROC_NULL have no blocks.
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommConnectedInDegree(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    NeighborDisplacements linDis(comm, sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Neighbor_alltoallv(recvbufAdjoints, linDis.recv.counts, linDis.recv.displs, linDis.recv.type, sendbufAdjoints, linDis.send.counts, linDis.send.displs, linDis.send.type, reverseComm);
+    transport.finish();
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // The neighbors that are MPI_PROC_NULL have no blocks.
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize * getCommConnectedInDegree(comm));
+    transport.recv(sendbufAdjoints, sendbufSize * getCommConnectedOutDegree(comm));
+    NeighborDisplacements* linDis = new NeighborDisplacements(comm, sendbufSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()), recvbufSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    request->setReverseData(reinterpret_cast<void*>(linDis), NeighborDisplacements::deleteFunc);
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, linDis->recv.counts, linDis->recv.displs, linDis->recv.type, sendbufAdjoints, linDis->send.counts, linDis->send.displs, linDis->send.type, reverseComm, &request->request);
+    transport.finish(request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommInDegree(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommOutDegree(comm), sendbufVectorSize);
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Neighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, reverseComm);
+    transport.finish();
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, int recvbufVectorSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request, AMPI_Comm reverseComm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    AdjointTransport transport(comm, sendtype->getADTool().getAdjointMpiType(), recvtype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufCounts, recvbufDispls, getCommInDegree(comm), recvbufVectorSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommOutDegree(comm), sendbufVectorSize);
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(sendtype->getADTool().getAdjointMpiType()));
+    VectorType recvbufType(recvbufVectorSize, transport.wireType(recvtype->getADTool().getAdjointMpiType()));
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, reverseComm, &request->request);
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Reduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+  void AMPI_Reduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
     if(root == getCommRank(comm)) {
-      MPI_Bcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+      transport.send(recvbufAdjoints, recvbufSize);
+      LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+      MPI_Bcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, getShadowComm(comm));
       std::swap(sendbufAdjoints, recvbufAdjoints);
     } else {
-      MPI_Bcast(sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+      transport.recv(sendbufAdjoints, sendbufSize);
+      LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+      MPI_Bcast(sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm));
     }
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Ireduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Ireduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
     if(root == getCommRank(comm)) {
-      MPI_Ibcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+      transport.send(recvbufAdjoints, recvbufSize);
+      LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+      MPI_Ibcast(recvbufAdjoints, recvbufType.count, recvbufType.type, root, getShadowComm(comm), &request->request);
       std::swap(sendbufAdjoints, recvbufAdjoints);
     } else {
-      MPI_Ibcast(sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+      transport.recv(sendbufAdjoints, sendbufSize);
+      LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+      MPI_Ibcast(sendbufAdjoints, sendbufType.count, sendbufType.type, root, getShadowComm(comm), &request->request);
     }
+    transport.finish(request);
   }
 #endif
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Allreduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+  void AMPI_Reduce_scatter_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommSize(comm), sendbufVectorSize);
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Allgatherv(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getShadowComm(comm));
+    transport.finish();
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, int sendbufVectorSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, const int* recvcounts, const int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(op);
+
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    transport.recv(sendbufAdjoints, sendbufCounts, sendbufDispls, getCommSize(comm), sendbufVectorSize);
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    VectorType sendbufType(sendbufVectorSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Iallgatherv(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufCounts, sendbufDispls, sendbufType.type, getShadowComm(comm), &request->request);
+    transport.finish(request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Allreduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
 
-    MPI_Allgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm);
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    if(isHierarchicalReverse(adType)) {
+      hierarchicalAdjointSum(recvbufAdjoints, sendbufAdjoints, recvbufSize, adType->getAdjointMpiType(), adType->getAdjointMpiSumOperator(), -1, comm);
+      return;
+    }
+#endif
+
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Allgather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm));
+    transport.finish();
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
-  void AMPI_Iallreduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+  void AMPI_Iallreduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, LargeCount sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, LargeCount recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
 
-    MPI_Iallgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
+    AdjointTransport transport(comm, datatype->getADTool().getAdjointMpiType());
+    transport.send(recvbufAdjoints, recvbufSize);
+    transport.recv(sendbufAdjoints, sendbufSize * getCommSize(comm));
+    LargeCountType recvbufType(recvbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    LargeCountType sendbufType(sendbufSize, transport.wireType(datatype->getADTool().getAdjointMpiType()));
+    MPI_Iallgather(recvbufAdjoints, recvbufType.count, recvbufType.type, sendbufAdjoints, sendbufType.count, sendbufType.type, getShadowComm(comm), &request->request);
+    transport.finish(request);
   }
 #endif
 }
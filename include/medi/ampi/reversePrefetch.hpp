@@ -0,0 +1,192 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <map>
+
+#include "adjointTransport.hpp"
+#include "chunkedReverse.hpp"
+#include "coalescing.hpp"
+#include "shadowComm.hpp"
+#include "../adjointInterface.hpp"
+#include "../mpiTools.h"
+#include "../typeDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /*
+   * The reverse of a send is a receive of the adjoint values, which is posted when the AD tool evaluates the handle.
+   * Messages from ranks that are ahead in the reverse evaluation arrive before and are stored by MPI as unexpected
+   * messages. The AD tool can post these receives in advance: during the reverse interpretation, it calls
+   * prefetchReverse for the handle that is evaluated next and the following handles in evaluation order, up to
+   * reversePrefetchDepth handles. It stops at the first handle for which prefetchReverse returns false. Handles that
+   * were already prefetched can be given again, they are skipped.
+   *
+   * The receives are matched by MPI in the order they are posted. The lookahead therefore stops at all handles that
+   * can not be prefetched, the receives are then still posted in the order of the reverse evaluation. All prefetched
+   * handles have to be evaluated afterwards.
+   */
+
+  /**
+   * @brief Access to the number of handles the AD tool looks ahead in the reverse evaluation, see prefetchReverse.
+   *
+   * A value of zero disables the prefetching. The value is read by the AD tool.
+   *
+   * @return Reference to the depth.
+   */
+  inline int& reversePrefetchDepth() {
+    static int depth = 0;
+
+    return depth;
+  }
+
+  /**
+   * @brief Set the number of handles the AD tool looks ahead in the reverse evaluation, see reversePrefetchDepth.
+   * @param[in] depth  The number of handles, zero disables the prefetching.
+   */
+  inline void setReversePrefetchDepth(int depth) {
+    mediAssert(0 <= depth);
+    reversePrefetchDepth() = depth;
+  }
+
+  /**
+   * @brief Post the receives of a handle in advance.
+   *
+   * @param[in,out]                h  The handle that is evaluated in the reverse sweep after the current position.
+   * @param[in]     adjointInterface  The interface of the AD tool for the reverse evaluation.
+   * @return False if the handle can not be prefetched, the AD tool stops the lookahead at this handle.
+   */
+  inline bool prefetchReverse(HandleBase* h, AdjointInterface* adjointInterface) {
+    if(NULL == h->funcPrefetch) {
+      return false;
+    }
+
+    return h->funcPrefetch(h, adjointInterface);
+  }
+
+  /**
+   * @brief An adjoint receive that is posted before the handle is evaluated.
+   *
+   * The buffer is created by the AD tool with the size of the handle and is handed over to the reverse function.
+   */
+  struct PrefetchedAdjointRecv {
+      MPI_Request request;
+      void* bufAdjoints;
+      AdjointTransport transport;
+
+      PrefetchedAdjointRecv(MPI_Comm comm, MPI_Datatype adjointType) :
+        request(MPI_REQUEST_NULL),
+        bufAdjoints(nullptr),
+        transport(comm, adjointType) {}
+  };
+
+  /**
+   * @brief Access to the posted receives of all prefetched handles.
+   *
+   * The map is kept per thread, a handle is prefetched and evaluated in the reverse sweep of the same tape.
+   *
+   * @return The map of the calling thread from the handles to their receives.
+   */
+  inline std::map<HandleBase*, PrefetchedAdjointRecv*>& getPrefetchedAdjointRecvs() {
+    static thread_local std::map<HandleBase*, PrefetchedAdjointRecv*> recvs;
+
+    return recvs;
+  }
+
+  /**
+   * @brief Post the adjoint receive for the reverse of a send in advance.
+   *
+   * Chunked messages and regions with reverse coalescing are not prefetched.
+   *
+   * @param[in,out]           handle  The handle of the send.
+   * @param[in]          bufSize  The number of adjoint values in the message.
+   * @param[in]        totalSize  The number of indices of the send buffer.
+   * @param[in]      adjointType  The adjoint MPI type of the AD tool.
+   * @param[in]             rank  The rank the send was addressed to.
+   * @param[in]              tag  The tag of the send.
+   * @param[in]             comm  The communicator of the send.
+   * @param[in] adjointInterface  The interface of the AD tool for the reverse evaluation.
+   * @return True if the receive is posted.
+   */
+  inline bool prefetchAdjointRecv(HandleBase* handle, LargeCount bufSize, int totalSize, MPI_Datatype adjointType,
+                                  int rank, int tag, MPI_Comm comm, AdjointInterface* adjointInterface) {
+    std::map<HandleBase*, PrefetchedAdjointRecv*>& recvs = getPrefetchedAdjointRecvs();
+    if(recvs.end() != recvs.find(handle)) {
+      return true;
+    }
+    if(nullptr != getActiveReverseCoalescingState(comm) || isReverseChunked(bufSize)) {
+      return false;
+    }
+
+    PrefetchedAdjointRecv* recv = new PrefetchedAdjointRecv(comm, adjointType);
+    adjointInterface->createAdjointTypeBuffer(recv->bufAdjoints, totalSize);
+
+    AdjointMessage message = recv->transport.recvMessage(recv->bufAdjoints, bufSize, adjointType);
+    LargeCountType bufType(message.count, message.type);
+    MPI_Irecv(message.buf, bufType.count, bufType.type, rank, tag, getShadowComm(comm), &recv->request);
+
+    recvs[handle] = recv;
+
+    return true;
+  }
+
+  /**
+   * @brief Complete the prefetched receive of a handle.
+   *
+   * The adjoint buffer of the handle is replaced by the buffer of the receive.
+   *
+   * @param[in]           handle  The handle that is evaluated.
+   * @param[in,out]  bufAdjoints  The adjoint buffer of the handle, it is deleted if a receive was prefetched.
+   * @param[in] adjointInterface  The interface of the AD tool for the reverse evaluation.
+   * @return False if no receive was prefetched for the handle.
+   */
+  inline bool receivePrefetchedAdjoints(HandleBase* handle, void*& bufAdjoints, AdjointInterface* adjointInterface) {
+    std::map<HandleBase*, PrefetchedAdjointRecv*>& recvs = getPrefetchedAdjointRecvs();
+    std::map<HandleBase*, PrefetchedAdjointRecv*>::iterator pos = recvs.find(handle);
+    if(recvs.end() == pos) {
+      return false;
+    }
+
+    PrefetchedAdjointRecv* recv = pos->second;
+    recvs.erase(pos);
+
+    MPI_Wait(&recv->request, MPI_STATUS_IGNORE);
+    recv->transport.finish();
+
+    adjointInterface->deleteAdjointTypeBuffer(bufAdjoints);
+    bufAdjoints = recv->bufAdjoints;
+    delete recv;
+
+    return true;
+  }
+}
@@ -0,0 +1,224 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "adjointTransport.hpp"
+#include "enums.hpp"
+#include "requestTable.hpp"
+#include "shadowComm.hpp"
+#include "../exceptions.hpp"
+#include "../macros.h"
+#include "../mpiTools.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the number of adjoint sends of blocking receives that can be in flight.
+   *
+   * The reverse of a blocking receive is a blocking send. If the window is larger than zero, the adjoints are copied
+   * and sent with the non-blocking counterpart instead. The reverse evaluation continues directly and the send is
+   * completed later: sends that have finished are retired whenever a new one is posted, and further sends are waited
+   * for if the window is full. All remaining sends are completed with waitReverseSends or in MPI_Finalize.
+   *
+   * Buffered sends are always local and keep the blocking call. A value of zero uses the blocking sends.
+   *
+   * @return Reference to the window size.
+   */
+  inline int& reverseSendWindow() {
+    static int window = 0;
+
+    return window;
+  }
+
+  /**
+   * @brief Set the number of adjoint sends of blocking receives that can be in flight, see reverseSendWindow.
+   * @param[in] window  The number of pending sends, zero for blocking sends.
+   */
+  inline void setReverseSendWindow(int window) {
+    mediAssert(0 <= window);
+    reverseSendWindow() = window;
+  }
+
+  /**
+   * @brief The adjoint sends of blocking receives that are still in flight.
+   *
+   * The requests and the copied messages are stored in a RequestTable. The finished sends are found with one
+   * MPI_Testsome call on the request array. The message buffers do not move if the table is modified.
+   *
+   * With the first send, an attribute is set on MPI_COMM_SELF. Its delete function is called at the beginning of
+   * MPI_Finalize and completes the remaining sends. The sends are kept per thread, each instance has its own
+   * attribute. If a thread ends before MPI_Finalize, the attribute is deleted in the destructor.
+   *
+   * The window can be raised for the current thread with minWindow, e.g. for a batch of reverse evaluations.
+   */
+  struct PendingReverseSends {
+      RequestTable<std::vector<char>> sends;
+      std::vector<int> completed;
+      int minWindow;
+      bool finalizeRegistered;
+      int keyval;
+
+      PendingReverseSends() :
+        sends(),
+        completed(),
+        minWindow(0),
+        finalizeRegistered(false),
+        keyval(MPI_KEYVAL_INVALID) {}
+
+      ~PendingReverseSends() {
+        if(finalizeRegistered) {
+          int finalized;
+          MPI_Finalized(&finalized);
+          if(!finalized) {
+            MPI_Comm_delete_attr(MPI_COMM_SELF, keyval);
+            MPI_Comm_free_keyval(&keyval);
+          }
+        }
+      }
+
+      /**
+       * @brief The number of sends that can be in flight.
+       * @return The larger value of reverseSendWindow and minWindow.
+       */
+      int window() const {
+        return std::max(reverseSendWindow(), minWindow);
+      }
+
+      /**
+       * @brief Copy the message and start the non-blocking counterpart of the reverse call.
+       *
+       * The copy covers the extent of all elements, the layout of the message type is preserved.
+       */
+      void post(const AdjointMessage& message, RecvAdjCall reverse_call, int dest, int tag, MPI_Comm comm) {
+        MPI_Aint lb;
+        MPI_Aint extent;
+        MPI_Type_get_extent(message.type, &lb, &extent);
+
+        if(!finalizeRegistered) {
+          registerFinalize();
+        }
+
+        char* buf = reinterpret_cast<char*>(message.buf);
+        int index = sends.add(std::vector<char>(buf, buf + message.count * extent));
+        char* data = sends.data[index].data();
+        MPI_Request* request = &sends.requests[index];
+
+        AdjointMessage copy = {data, message.count, message.type};
+        isendAdjointMessage(copy, getNonBlockingCall(reverse_call), dest, tag, comm, request);
+
+        retire();
+      }
+
+      /**
+       * @brief Remove the finished sends and wait for further sends until the window is not exceeded.
+       */
+      void retire() {
+        if(sends.empty()) {
+          return;
+        }
+
+        int outcount;
+        completed.resize(sends.size());
+        MPI_Testsome(sends.size(), sends.requests.data(), &outcount, completed.data(), MPI_STATUSES_IGNORE);
+        if(MPI_UNDEFINED != outcount) {
+          sends.remove(completed.data(), outcount);
+        }
+
+        while(sends.size() > window()) {
+          int index;
+          MPI_Waitany(sends.size(), sends.requests.data(), &index, MPI_STATUS_IGNORE);
+          sends.remove(index);
+        }
+      }
+
+      void waitAll() {
+        MPI_Waitall(sends.size(), sends.requests.data(), MPI_STATUSES_IGNORE);
+        sends.clear();
+      }
+
+    private:
+
+      void registerFinalize() {
+        if(MPI_KEYVAL_INVALID == keyval) {
+          keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, finalizeFunc);
+        }
+        MPI_Comm_set_attr(MPI_COMM_SELF, keyval, reinterpret_cast<void*>(this));
+
+        finalizeRegistered = true;
+      }
+
+      static int finalizeFunc(MPI_Comm comm, int keyval, void* attribute, void* extraState) {
+        MEDI_UNUSED(comm);
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        PendingReverseSends* pending = reinterpret_cast<PendingReverseSends*>(attribute);
+        pending->waitAll();
+        pending->finalizeRegistered = false;
+
+        return MPI_SUCCESS;
+      }
+  };
+
+  /**
+   * @brief Access to the adjoint sends of blocking receives that are in flight.
+   * @return The pending sends of the calling thread.
+   */
+  inline PendingReverseSends& getPendingReverseSends() {
+    static thread_local PendingReverseSends pending;
+
+    return pending;
+  }
+
+  /**
+   * @brief Check if the reverse of a blocking receive is posted as a non-blocking send.
+   * @param[in] reverse_call  The send call of the reverse evaluation.
+   * @return True if the reverse send window is enabled for the thread and the call is not a buffered send.
+   */
+  inline bool isWindowedReverseSend(RecvAdjCall reverse_call) {
+    return 0 < getPendingReverseSends().window() && RecvAdjCall::Bsend != reverse_call;
+  }
+
+  /**
+   * @brief Complete all adjoint sends of blocking receives that are still in flight.
+   *
+   * Should be called at the end of a reverse evaluation, the buffers of the remaining sends are released afterwards.
+   * Only the sends of the calling thread are completed.
+   */
+  inline void waitReverseSends() {
+    getPendingReverseSends().waitAll();
+  }
+}
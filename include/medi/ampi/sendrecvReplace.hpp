@@ -0,0 +1,260 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include "async.hpp"
+#include "reverseFunctions.hpp"
+#include "forwardFunctions.hpp"
+#include "primalFunctions.hpp"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+
+  /*
+   * Sendrecv_replace uses the same buffer for the send and the receive. The send and receive indices are stored
+   * separately but only one buffer is used for the primal or adjoint values during the reverse evaluation. It is
+   * communicated with MPI_Sendrecv_replace, where source and destination are swapped.
+   */
+
+  template<typename DATATYPE>
+  struct AMPI_Sendrecv_replace_AdjointHandle : public HandleBase {
+    int bufTotalSize;
+    typename DATATYPE::IndexType* bufSendIndices;
+    typename DATATYPE::IndexType* bufRecvIndices;
+    typename DATATYPE::PrimalType* bufPrimals;
+    typename DATATYPE::PrimalType* bufOldPrimals;
+    /* required for async */ void* bufAdjoints;
+    int bufCount;
+    LargeCount bufCountVec;
+    int count;
+    DATATYPE* datatype;
+    int dest;
+    int sendtag;
+    int source;
+    int recvtag;
+    AMPI_Comm comm;
+
+    ~AMPI_Sendrecv_replace_AdjointHandle () {
+      if(nullptr != bufSendIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(bufSendIndices);
+        bufSendIndices = nullptr;
+      }
+      if(nullptr != bufRecvIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(bufRecvIndices);
+        bufRecvIndices = nullptr;
+      }
+      if(nullptr != bufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(bufPrimals);
+        bufPrimals = nullptr;
+      }
+      if(nullptr != bufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(bufOldPrimals);
+        bufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Sendrecv_replace_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>*>
+      (handle);
+
+    MPI_Status status;
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->bufSendIndices, h->bufPrimals, h->bufTotalSize);
+
+
+    AMPI_Sendrecv_replace_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->sendtag,
+                                        h->source, h->recvtag, h->comm, &status);
+
+    if(h->datatype->getADTool().isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->bufRecvIndices, h->bufOldPrimals, h->bufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->bufRecvIndices, h->bufPrimals, h->bufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Sendrecv_replace_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>*>
+      (handle);
+
+    MPI_Status status;
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->bufSendIndices, h->bufAdjoints, h->bufTotalSize);
+
+
+    AMPI_Sendrecv_replace_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->sendtag,
+                                        h->source, h->recvtag, h->comm, &status);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->bufRecvIndices, h->bufAdjoints, h->bufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Sendrecv_replace_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>*>
+      (handle);
+
+    MPI_Status status;
+    h->bufAdjoints = nullptr;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
+    adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->bufRecvIndices, h->bufAdjoints, h->bufTotalSize);
+
+    if(h->datatype->getADTool().isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->bufRecvIndices, h->bufOldPrimals, h->bufTotalSize);
+    }
+
+    AMPI_Sendrecv_replace_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->sendtag,
+                                        h->source, h->recvtag, h->comm, &status);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->bufSendIndices, h->bufAdjoints, h->bufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Sendrecv_replace(typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int sendtag,
+                            int source, int recvtag, AMPI_Comm comm, AMPI_Status* status) {
+    int rStatus;
+
+    if(!datatype->getADTool().isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Sendrecv_replace(buf, count, datatype->getMpiType(), dest, sendtag, source, recvtag, comm, status);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>* h = nullptr;
+      // the same modified buffer is used for the send and the receive
+      typename DATATYPE::ModifiedType* bufMod = nullptr;
+      int bufElements = 0;
+
+      // compute the total size of the buffer
+      bufElements = count;
+
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->createModifiedTypeBuffer(bufMod, bufElements);
+      } else {
+        bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(buf);
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(datatype->getADTool().isHandleRequired()) {
+        h = new AMPI_Sendrecv_replace_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->bufCount = datatype->computeActiveElements(count);
+        h->bufTotalSize = datatype->computeActiveElements(bufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->bufSendIndices, h->bufTotalSize);
+        datatype->getADTool().createIndexTypeBuffer(h->bufRecvIndices, h->bufTotalSize);
+
+
+        // extract the old primal values from the buffer if the AD tool
+        // needs the primal values reset
+        if(datatype->getADTool().isOldPrimalsRequired()) {
+          datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
+          datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
+        }
+
+
+        // the send indices need to be extracted before the indices for the receive are created
+        datatype->getIndices(buf, 0, h->bufSendIndices, 0, count);
+
+        datatype->createIndices(buf, 0, h->bufRecvIndices, 0, count);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Sendrecv_replace_b<DATATYPE>;
+        h->funcForward = AMPI_Sendrecv_replace_d<DATATYPE>;
+        h->funcPrimal = AMPI_Sendrecv_replace_p<DATATYPE>;
+        h->count = count;
+        h->datatype = datatype;
+        h->dest = dest;
+        h->sendtag = sendtag;
+        h->source = source;
+        h->recvtag = recvtag;
+        h->comm = comm;
+      }
+
+      if(!datatype->isModifiedBufferRequired()) {
+        datatype->clearIndices(buf, 0, count);
+      }
+
+      rStatus = MPI_Sendrecv_replace(bufMod, count, datatype->getModifiedMpiType(), dest, sendtag, source, recvtag, comm,
+                                     status);
+      datatype->getADTool().addToolAction(h);
+
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(buf, 0, h->bufRecvIndices, h->bufOldPrimals, 0, count);
+      }
+
+      datatype->getADTool().stopAssembly(h);
+
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->deleteModifiedTypeBuffer(bufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+}
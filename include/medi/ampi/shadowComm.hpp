@@ -0,0 +1,241 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include "../macros.h"
+#include "../mpiTools.h"
+
+#include "../generated/ampiDefinitions.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Attribute delete function for the shadow communicator of a user communicator.
+   */
+  inline int deleteShadowComm(MPI_Comm comm, int keyval, void* attributeVal, void* extraState) {
+    MEDI_UNUSED(comm);
+    MEDI_UNUSED(keyval);
+    MEDI_UNUSED(extraState);
+
+    MPI_Comm* shadow = reinterpret_cast<MPI_Comm*>(attributeVal);
+    MPI_Comm_free(shadow);
+    delete shadow;
+
+    return MPI_SUCCESS;
+  }
+
+  /**
+   * @brief The key for the shadow communicator attribute.
+   * @return The keyval, it is created on the first call.
+   */
+  inline int getShadowCommKeyval() {
+    static int keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, deleteShadowComm);
+
+    return keyval;
+  }
+
+  /**
+   * @brief Create the shadow communicator for the adjoint messages of a user communicator.
+   *
+   * The shadow communicator is a duplicate of the user communicator and is cached as an attribute of it. Adjoint
+   * messages on it can not match primal messages or wildcard receives of the user. MeDiPack does not use wildcards for
+   * adjoint messages, the communicator is therefore created with the mpi_assert_no_any_tag and
+   * mpi_assert_no_any_source hints.
+   *
+   * The call is collective over the communicator. It does nothing if the shadow communicator already exists.
+   *
+   * @param[in] comm  The user communicator.
+   */
+  inline void createShadowComm(MPI_Comm comm) {
+    if(MPI_COMM_NULL == comm) {
+      return;
+    }
+
+    MPI_Comm* shadow;
+    int flag;
+    MPI_Comm_get_attr(comm, getShadowCommKeyval(), &shadow, &flag);
+    if(!flag) {
+      shadow = new MPI_Comm;
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+      MPI_Info info;
+      MPI_Info_create(&info);
+      MPI_Info_set(info, "mpi_assert_no_any_tag", "true");
+      MPI_Info_set(info, "mpi_assert_no_any_source", "true");
+      MPI_Comm_dup_with_info(comm, info, shadow);
+      MPI_Info_free(&info);
+#else
+      MPI_Comm_dup(comm, shadow);
+#endif
+      MPI_Comm_set_attr(comm, getShadowCommKeyval(), shadow);
+    }
+  }
+
+  /**
+   * @brief Get the communicator for the adjoint messages of a user communicator.
+   *
+   * @param[in] comm  The user communicator.
+   * @return The shadow communicator if it was created, otherwise the user communicator.
+   */
+  inline MPI_Comm getShadowComm(MPI_Comm comm) {
+    MPI_Comm* shadow;
+    int flag;
+    MPI_Comm_get_attr(comm, getShadowCommKeyval(), &shadow, &flag);
+    if(flag) {
+      return *shadow;
+    } else {
+      return comm;
+    }
+  }
+
+  /*
+   * The shadow communicators are created with the user communicators, since all ranks of the communicator take part
+   * in these calls.
+   */
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_create(AMPI_Comm comm, AMPI_Group group, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_create(comm, group, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_create_group(AMPI_Comm comm, AMPI_Group group, int tag, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_create_group(comm, group, tag, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_dup(AMPI_Comm comm, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_dup(comm, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_dup_with_info(AMPI_Comm comm, AMPI_Info info, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_dup_with_info(comm, info, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_split(AMPI_Comm comm, int color, int key, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_split(comm, color, key, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Comm_split_type(AMPI_Comm comm, int split_type, int key, AMPI_Info info, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Comm_split_type(comm, split_type, key, info, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Cart_create(AMPI_Comm comm_old, int ndims, MEDI_OPTIONAL_CONST int* dims,
+                              MEDI_OPTIONAL_CONST int* periods, int reorder, AMPI_Comm* comm_cart) {
+    int rStatus = MPI_Cart_create(comm_old, ndims, dims, periods, reorder, comm_cart);
+
+    createShadowComm(*comm_cart);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Cart_sub(AMPI_Comm comm, MEDI_OPTIONAL_CONST int* remain_dims, AMPI_Comm* newcomm) {
+    int rStatus = MPI_Cart_sub(comm, remain_dims, newcomm);
+
+    createShadowComm(*newcomm);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  inline int AMPI_Dist_graph_create(AMPI_Comm comm_old, int n, MEDI_OPTIONAL_CONST int* sources,
+                                    MEDI_OPTIONAL_CONST int* degrees, MEDI_OPTIONAL_CONST int* destinations, MEDI_OPTIONAL_CONST int* weights,
+                                    AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
+    int rStatus = MPI_Dist_graph_create(comm_old, n, sources, degrees, destinations, weights, info, reorder, comm_dist_graph);
+
+    createShadowComm(*comm_dist_graph);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  inline int AMPI_Dist_graph_create_adjacent(AMPI_Comm comm_old, int indegree, MEDI_OPTIONAL_CONST int* sources,
+      MEDI_OPTIONAL_CONST int* sourceweights, int outdegree, MEDI_OPTIONAL_CONST int* destinations,
+      MEDI_OPTIONAL_CONST int* destweights, AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
+    int rStatus = MPI_Dist_graph_create_adjacent(comm_old, indegree, sources, sourceweights, outdegree, destinations, destweights,
+                                          info, reorder, comm_dist_graph);
+
+    createShadowComm(*comm_dist_graph);
+
+    return rStatus;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  inline int AMPI_Graph_create(AMPI_Comm comm_old, int nnodes, MEDI_OPTIONAL_CONST int* index,
+                               MEDI_OPTIONAL_CONST int* edges, int reorder, AMPI_Comm* comm_graph) {
+    int rStatus = MPI_Graph_create(comm_old, nnodes, index, edges, reorder, comm_graph);
+
+    createShadowComm(*comm_graph);
+
+    return rStatus;
+  }
+#endif
+}
@@ -0,0 +1,256 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include "../exceptions.hpp"
+#include "../macros.h"
+#include "../mpiTools.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Access to the density threshold for the sparse encoding of adjoint messages.
+   *
+   * If at most this fraction of the adjoint values in a message is non-zero, the message is sent as index and value
+   * pairs. Every encoded message starts with a one byte header that selects the dense or the sparse format. A value
+   * of zero disables the encoding, then the messages have no header.
+   *
+   * The encoding is used in the reverse evaluation of the point-to-point operations and of the blocking Alltoallv.
+   * Messages in a coalescing region are not encoded. The value needs to be the same on all ranks during the reverse
+   * evaluation. Dense messages are one byte larger than without the encoding, which needs to be considered for the
+   * buffer of Bsend.
+   *
+   * @return Reference to the threshold.
+   */
+  inline double& adjointSparseDensity() {
+    static double density = 0.0;
+
+    return density;
+  }
+
+  /**
+   * @brief Set the density threshold for the sparse encoding of adjoint messages.
+   * @param[in] density  The maximum fraction of non-zero values for the sparse format.
+   */
+  inline void setAdjointSparseDensity(double density) {
+    adjointSparseDensity() = density;
+  }
+
+  /**
+   * @brief Header values of the encoded adjoint messages.
+   */
+  enum class SparseEncodingFormat : char {
+    Dense = 0,  ///< The header is followed by all values.
+    Sparse = 1  ///< The header is followed by the number of pairs, the indices and the values.
+  };
+
+  /**
+   * @brief The size of one adjoint value for the sparse encoding.
+   *
+   * Only types without gaps can be encoded, the values are compared bytewise with zero.
+   *
+   * @param[in] type  The MPI type of the adjoint values on the wire.
+   * @return The size of the type or zero if the encoding is disabled or not possible for the type.
+   */
+  inline int getSparseEncodingElementBytes(MPI_Datatype type) {
+    if(0.0 >= adjointSparseDensity()) {
+      return 0;
+    }
+
+    int size;
+    MPI_Aint lb;
+    MPI_Aint extent;
+    MPI_Type_size(type, &size);
+    MPI_Type_get_extent(type, &lb, &extent);
+    if(0 != lb || (MPI_Aint)size != extent) {
+      return 0;
+    }
+
+    return size;
+  }
+
+  /**
+   * @brief The largest size of an encoded message.
+   *
+   * @param[in]     elements  The number of adjoint values.
+   * @param[in] elementBytes  The size of one adjoint value.
+   * @return The size of the dense format in bytes.
+   */
+  inline LargeCount getMaxEncodedBytes(LargeCount elements, int elementBytes) {
+    if(0 == elements) {
+      return 0;
+    }
+
+    return 1 + elements * elementBytes;
+  }
+
+  /**
+   * @brief Encode adjoint values in the dense or the sparse format, whichever is selected by the threshold.
+   *
+   * @param[in]           buf  The adjoint values.
+   * @param[in]      elements  The number of adjoint values.
+   * @param[in]  elementBytes  The size of one adjoint value.
+   * @param[out]      encoded  The encoded message, needs to hold getMaxEncodedBytes bytes.
+   * @return The size of the encoded message in bytes.
+   */
+  inline LargeCount encodeAdjoints(const void* buf, LargeCount elements, int elementBytes, char* encoded) {
+    if(0 == elements) {
+      return 0;
+    }
+
+    const char* data = reinterpret_cast<const char*>(buf);
+    std::vector<char> zero(elementBytes, 0);
+
+    LargeCount nonZeros = 0;
+    for(LargeCount i = 0; i < elements; ++i) {
+      if(0 != std::memcmp(data + i * elementBytes, zero.data(), elementBytes)) {
+        nonZeros += 1;
+      }
+    }
+
+    LargeCount sparseBytes = 1 + (LargeCount)sizeof(LargeCount) + nonZeros * ((LargeCount)sizeof(LargeCount) + elementBytes);
+    if(nonZeros > adjointSparseDensity() * elements || sparseBytes >= getMaxEncodedBytes(elements, elementBytes)) {
+      encoded[0] = (char)SparseEncodingFormat::Dense;
+      std::memcpy(encoded + 1, data, elements * elementBytes);
+
+      return getMaxEncodedBytes(elements, elementBytes);
+    }
+
+    encoded[0] = (char)SparseEncodingFormat::Sparse;
+    std::memcpy(encoded + 1, &nonZeros, sizeof(LargeCount));
+    char* indices = encoded + 1 + sizeof(LargeCount);
+    char* values = indices + nonZeros * sizeof(LargeCount);
+    for(LargeCount i = 0; i < elements; ++i) {
+      if(0 != std::memcmp(data + i * elementBytes, zero.data(), elementBytes)) {
+        std::memcpy(indices, &i, sizeof(LargeCount));
+        std::memcpy(values, data + i * elementBytes, elementBytes);
+        indices += sizeof(LargeCount);
+        values += elementBytes;
+      }
+    }
+
+    return sparseBytes;
+  }
+
+  /**
+   * @brief Decode a message that was created with encodeAdjoints.
+   *
+   * @param[in]      encoded  The encoded message.
+   * @param[out]         buf  The adjoint values, all values that are not in a sparse message are set to zero.
+   * @param[in]     elements  The number of adjoint values.
+   * @param[in] elementBytes  The size of one adjoint value.
+   */
+  inline void decodeAdjoints(const char* encoded, void* buf, LargeCount elements, int elementBytes) {
+    if(0 == elements) {
+      return;
+    }
+
+    char* data = reinterpret_cast<char*>(buf);
+    if((char)SparseEncodingFormat::Dense == encoded[0]) {
+      std::memcpy(data, encoded + 1, elements * elementBytes);
+    } else {
+      std::memset(data, 0, elements * elementBytes);
+
+      LargeCount nonZeros;
+      std::memcpy(&nonZeros, encoded + 1, sizeof(LargeCount));
+      const char* indices = encoded + 1 + sizeof(LargeCount);
+      const char* values = indices + nonZeros * sizeof(LargeCount);
+      for(LargeCount i = 0; i < nonZeros; ++i) {
+        LargeCount index;
+        std::memcpy(&index, indices + i * sizeof(LargeCount), sizeof(LargeCount));
+        std::memcpy(data + index * elementBytes, values + i * elementBytes, elementBytes);
+      }
+    }
+  }
+
+  /**
+   * @brief Alltoallv exchange of adjoint values with the sparse encoding of each block.
+   *
+   * The sizes of the encoded blocks are exchanged first. The arguments are the same as for MPI_Alltoallv, the type
+   * is described by the size of its elements, see getSparseEncodingElementBytes.
+   */
+  inline void encodedAlltoallv(void* sendbuf, const int* sendcounts, const int* sdispls, void* recvbuf,
+                               const int* recvcounts, const int* rdispls, int elementBytes, MPI_Comm comm) {
+    int ranks = getCommSize(comm);
+
+    int* sendBytes = new int[ranks];
+    int* sendByteDispls = new int[ranks];
+    int* recvBytes = new int[ranks];
+    int* recvByteDispls = new int[ranks];
+
+    LargeCount sendTotal = 0;
+    LargeCount recvTotal = 0;
+    for(int i = 0; i < ranks; ++i) {
+      sendTotal += getMaxEncodedBytes(sendcounts[i], elementBytes);
+      recvTotal += getMaxEncodedBytes(recvcounts[i], elementBytes);
+    }
+    if(sendTotal > INT_MAX || recvTotal > INT_MAX) {
+      MEDI_EXCEPTION("The encoded adjoint blocks of Alltoallv exceed the range of int.");
+    }
+
+    std::vector<char> encoded(sendTotal);
+    int position = 0;
+    for(int i = 0; i < ranks; ++i) {
+      sendByteDispls[i] = position;
+      sendBytes[i] = (int)encodeAdjoints(reinterpret_cast<char*>(sendbuf) + (LargeCount)sdispls[i] * elementBytes,
+                                         sendcounts[i], elementBytes, encoded.data() + position);
+      position += sendBytes[i];
+    }
+
+    MPI_Alltoall(sendBytes, 1, MPI_INT, recvBytes, 1, MPI_INT, comm);
+
+    position = 0;
+    for(int i = 0; i < ranks; ++i) {
+      recvByteDispls[i] = position;
+      position += recvBytes[i];
+    }
+
+    std::vector<char> received(recvTotal);
+    MPI_Alltoallv(encoded.data(), sendBytes, sendByteDispls, MPI_BYTE, received.data(), recvBytes, recvByteDispls,
+                  MPI_BYTE, comm);
+
+    for(int i = 0; i < ranks; ++i) {
+      decodeAdjoints(received.data() + recvByteDispls[i],
+                     reinterpret_cast<char*>(recvbuf) + (LargeCount)rdispls[i] * elementBytes, recvcounts[i], elementBytes);
+    }
+
+    delete [] sendBytes;
+    delete [] sendByteDispls;
+    delete [] recvBytes;
+    delete [] recvByteDispls;
+  }
+}
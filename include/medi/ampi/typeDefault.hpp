@@ -31,6 +31,7 @@
 #include <new>
 
 #include "../macros.h"
+#include "parallelElements.hpp"
 #include "typeInterface.hpp"
 #include "op.hpp"
 
@@ -109,33 +110,47 @@ namespace medi {
 
       inline void copyIntoModifiedBuffer(const Type* buf, size_t bufOffset, ModifiedType* bufMod, size_t bufModOffset, int elements) const {
         if(adTool->isModifiedBufferRequired()) {
-          for(int i = 0; i < elements; ++i) {
+          forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
             ADTool::setIntoModifyBuffer(bufMod[bufModOffset + i], buf[bufOffset + i]);
-          }
+          });
         }
       }
 
       inline void copyFromModifiedBuffer(Type* buf, size_t bufOffset, const ModifiedType* bufMod, size_t bufModOffset, int elements) const {
         if(adTool->isModifiedBufferRequired()) {
-          for(int i = 0; i < elements; ++i) {
+          forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
             ADTool::getFromModifyBuffer(bufMod[bufModOffset + i], buf[bufOffset + i]);
-          }
+          });
         }
       }
 
       inline void getIndices(const Type* buf, size_t bufOffset, IndexType* indices, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
+        forEachElement(elements, isParallelElementLoop(elements), [&](int i) {
           indices[indexOffset + i] = ADTool::getIndex(buf[bufOffset + i]);
-        }
+        });
       }
 
       inline void registerValue(Type* buf, size_t bufOffset, IndexType* indices, PrimalType* oldPrimals, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
-          ADTool::registerValue(buf[bufOffset + i], oldPrimals[indexOffset + i], indices[indexOffset + i]);
+        ParallelIndexCreation const& state = parallelIndexCreation();
+        if(state.active) {
+          // Part of a constructed datatype whose elements are registered in parallel.
+          for(int i = 0; i < elements; ++i) {
+            ADTool::registerValueAt(buf[bufOffset + i], oldPrimals[indexOffset + i], indices[indexOffset + i],
+                                    (int)(indexOffset + i - state.indexBase));
+          }
+        } else if(beginParallelIndices(*adTool, elements, elements, indexOffset)) {
+          forEachElement(elements, true, [&](int i) {
+            ADTool::registerValueAt(buf[bufOffset + i], oldPrimals[indexOffset + i], indices[indexOffset + i], i);
+          });
+          endParallelIndices(*adTool);
+        } else {
+          for(int i = 0; i < elements; ++i) {
+            ADTool::registerValue(buf[bufOffset + i], oldPrimals[indexOffset + i], indices[indexOffset + i]);
+          }
         }
       }
 
@@ -148,17 +163,30 @@ namespace medi {
       inline void createIndices(Type* buf, size_t bufOffset, IndexType* indices, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
-          ADTool::createIndex(buf[bufOffset + i], indices[indexOffset + i]);
+        ParallelIndexCreation const& state = parallelIndexCreation();
+        if(state.active) {
+          // Part of a constructed datatype whose elements receive their indices in parallel.
+          for(int i = 0; i < elements; ++i) {
+            ADTool::createIndexAt(buf[bufOffset + i], indices[indexOffset + i], (int)(indexOffset + i - state.indexBase));
+          }
+        } else if(beginParallelIndices(*adTool, elements, elements, indexOffset)) {
+          forEachElement(elements, true, [&](int i) {
+            ADTool::createIndexAt(buf[bufOffset + i], indices[indexOffset + i], i);
+          });
+          endParallelIndices(*adTool);
+        } else {
+          for(int i = 0; i < elements; ++i) {
+            ADTool::createIndex(buf[bufOffset + i], indices[indexOffset + i]);
+          }
         }
       }
 
       inline void getValues(const Type* buf, size_t bufOffset, PrimalType* primals, size_t bufModOffset, int elements) const {
         int primalOffset = computeActiveElements((int)bufModOffset);
 
-        for(int pos = 0; pos < elements; ++pos) {
+        forEachElement(elements, isParallelElementLoop(elements), [&](int pos) {
           primals[primalOffset + pos] = ADTool::getValue(buf[bufOffset + pos]);
-        }
+        });
       }
 
       inline void performReduce(Type* buf, Type* target, int count, AMPI_Op op, int ranks) const {
@@ -71,6 +71,12 @@ namespace medi {
           int index;
       };
 
+      struct PrimalIntOwner {
+          PrimalType value;
+          int index;
+          int owner;
+      };
+
       static void unmodifiedAdd(Type* invec, Type* inoutvec, int* len, MPI_Datatype* datatype) {
         MEDI_UNUSED(datatype);
 
@@ -226,6 +232,62 @@ namespace medi {
         }
       }
 
+      static void packOwner(const Type* buf, const PrimalType* primals, PrimalIntOwner* ownerBuf, int count, int rank) {
+        MEDI_UNUSED(buf);
+
+        for(int i = 0; i < count; ++i) {
+          ownerBuf[i].value = primals[i];
+          ownerBuf[i].index = 0;
+          ownerBuf[i].owner = rank;
+        }
+      }
+
+      static void packOwnerLoc(const TypeInt* buf, const PrimalType* primals, PrimalIntOwner* ownerBuf, int count, int rank) {
+        for(int i = 0; i < count; ++i) {
+          ownerBuf[i].value = primals[i];
+          ownerBuf[i].index = buf[i].index;
+          ownerBuf[i].owner = rank;
+        }
+      }
+
+      static void unpackOwner(const PrimalIntOwner* ownerBuf, int* owners, int count) {
+        for(int i = 0; i < count; ++i) {
+          owners[i] = ownerBuf[i].owner;
+        }
+      }
+
+      static void ownerMax(PrimalIntOwner* invec, PrimalIntOwner* inoutvec, int* len, MPI_Datatype* datatype) {
+        MEDI_UNUSED(datatype);
+
+        for(int i = 0; i < *len; ++i) {
+          // ties are resolved first by the index and then by the rank, such that all ranks select the same owner
+          if(invec[i].value > inoutvec[i].value) {
+            inoutvec[i] = invec[i];
+          } else if(invec[i].value == inoutvec[i].value) {
+            if(invec[i].index < inoutvec[i].index ||
+               (invec[i].index == inoutvec[i].index && invec[i].owner < inoutvec[i].owner)) {
+              inoutvec[i] = invec[i];
+            }
+          }
+        }
+      }
+
+      static void ownerMin(PrimalIntOwner* invec, PrimalIntOwner* inoutvec, int* len, MPI_Datatype* datatype) {
+        MEDI_UNUSED(datatype);
+
+        for(int i = 0; i < *len; ++i) {
+          // ties are resolved first by the index and then by the rank, such that all ranks select the same owner
+          if(invec[i].value < inoutvec[i].value) {
+            inoutvec[i] = invec[i];
+          } else if(invec[i].value == inoutvec[i].value) {
+            if(invec[i].index < inoutvec[i].index ||
+               (invec[i].index == inoutvec[i].index && invec[i].owner < inoutvec[i].owner)) {
+              inoutvec[i] = invec[i];
+            }
+          }
+        }
+      }
+
 //      TODO: These are currently not used since we can not handle zero terms. Need to implement
 //            a tracking of how many zeros the multiplication contained.
 //
@@ -285,6 +347,24 @@ namespace medi {
         AMPI_Op_create((MPI_User_function*)FuncHelp::unmodifiedMax, 1, &OP_MAX);
         AMPI_Op_create((MPI_User_function*)FuncHelp::unmodifiedMinLoc, 1, &OP_MINLOC);
         AMPI_Op_create((MPI_User_function*)FuncHelp::unmodifiedMaxLoc, 1, &OP_MAXLOC);
+
+        OP_MIN.initOwner((MPI_User_function*)FuncHelp::ownerMin, createOwnerType(),
+                         (PackOwnerOperation)FuncHelp::packOwner, (UnpackOwnerOperation)FuncHelp::unpackOwner);
+        OP_MAX.initOwner((MPI_User_function*)FuncHelp::ownerMax, createOwnerType(),
+                         (PackOwnerOperation)FuncHelp::packOwner, (UnpackOwnerOperation)FuncHelp::unpackOwner);
+        OP_MINLOC.initOwner((MPI_User_function*)FuncHelp::ownerMin, createOwnerType(),
+                            (PackOwnerOperation)FuncHelp::packOwnerLoc, (UnpackOwnerOperation)FuncHelp::unpackOwner);
+        OP_MAXLOC.initOwner((MPI_User_function*)FuncHelp::ownerMax, createOwnerType(),
+                            (PackOwnerOperation)FuncHelp::packOwnerLoc, (UnpackOwnerOperation)FuncHelp::unpackOwner);
+      }
+
+      static MPI_Datatype createOwnerType() {
+        // The owner buffers are only evaluated by the owner functions, so the layout is not required by mpi.
+        MPI_Datatype ownerType;
+        MPI_Type_contiguous(sizeof(typename FuncHelp::PrimalIntOwner), MPI_BYTE, &ownerType);
+        MPI_Type_commit(&ownerType);
+
+        return ownerType;
       }
 
       AMPI_Op convertOperator(AMPI_Op op) const {
@@ -31,6 +31,9 @@
 #include "async.hpp"
 #include "ampiMisc.h"
 #include "inPlace.hpp"
+#include "progressThread.hpp"
+#include "shadowComm.hpp"
+#include "../displacementTools.hpp"
 #include "../mpiTools.h"
 
 #include "../generated/ampiDefinitions.h"
@@ -71,6 +74,28 @@ namespace medi {
   }
 #endif
 
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_wrap(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm);
+
+  inline int MPI_Reduce_scatter_wrap(MEDI_OPTIONAL_CONST void* sendbuf, void* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, MPI_Datatype type, MPI_Op op, MPI_Comm comm) {
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    return MPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, type, op, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_wrap(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, const int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request);
+
+  inline int MPI_Ireduce_scatter_wrap(MEDI_OPTIONAL_CONST void* sendbuf, void* recvbuf, const int* recvcounts, const int* displs, int recvcount, MPI_Datatype type, MPI_Op op, MPI_Comm comm, MPI_Request* request) {
+    MEDI_UNUSED(displs);
+    MEDI_UNUSED(recvcount);
+    return MPI_Ireduce_scatter(sendbuf, recvbuf, recvcounts, type, op, comm, request);
+  }
+#endif
+
   template<typename DATATYPE>
   struct AMPI_Ireduce_local_Handle : public AsyncHandle {
       AMPI_Comm comm;
@@ -97,6 +122,10 @@ namespace medi {
   int AMPI_Allreduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm);
   template<typename SENDTYPE, typename RECVTYPE>
   int AMPI_Allgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs, RECVTYPE* recvtype, int root, AMPI_Comm comm);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm);
   template<typename DATATYPE>
   int AMPI_Ireduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request);
   template<typename SENDTYPE, typename RECVTYPE>
@@ -146,6 +175,103 @@ namespace medi {
     return rValue;
   }
 
+  /**
+   * @brief Determines for each element the rank that provides the selected value of the operator.
+   *
+   * Only the primal values are reduced, the AD tool does not record anything.
+   */
+  template<typename DATATYPE>
+  inline void computeOwners(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int* owners, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    typename DATATYPE::PrimalType* primals = nullptr;
+    datatype->getADTool().createPrimalTypeBuffer(primals, count);
+    datatype->getValues(buf, 0, primals, 0, count);
+
+    int ownerSize;
+    MPI_Type_size(op.ownerMpiType, &ownerSize);
+    char* ownerBuf = new char[(size_t)ownerSize * count];
+
+    op.packOwnerOperation(buf, primals, ownerBuf, count, getCommRank(comm));
+    MPI_Allreduce(MPI_IN_PLACE, ownerBuf, count, op.ownerMpiType, op.ownerFunction, comm);
+    op.unpackOwnerOperation(ownerBuf, owners, count);
+
+    delete [] ownerBuf;
+    datatype->getADTool().deletePrimalTypeBuffer(primals);
+  }
+
+  /**
+   * @brief Reduction for operators that select one of the input values, e.g. min or max.
+   *
+   * The owner of each value is determined first. Afterwards each rank sends only the values it owns with a (all)gatherv
+   * operation. The reverse of the gather then sends each adjoint value only back to its owner.
+   */
+  template<typename DATATYPE>
+  inline int GatherFromOwners(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+    int commSize = getCommSize(comm);
+    int commRank = getCommRank(comm);
+
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufOwner = sendbuf;
+    if(AMPI_IN_PLACE == sendbuf) {
+      sendbufOwner = recvbuf;
+    }
+
+    int* owners = new int[count];
+    computeOwners<DATATYPE>(sendbufOwner, owners, count, datatype, op, comm);
+
+    int* recvcounts = new int[commSize];
+    int* displs = new int[commSize];
+    for(int i = 0; i < commSize; ++i) {
+      recvcounts[i] = 0;
+    }
+    for(int i = 0; i < count; ++i) {
+      recvcounts[owners[i]] += 1;
+    }
+    displs[0] = 0;
+    for(int i = 1; i < commSize; ++i) {
+      displs[i] = displs[i - 1] + recvcounts[i - 1];
+    }
+
+    // copy the values owned by this rank into a linear buffer
+    int ownedCount = recvcounts[commRank];
+    typename DATATYPE::Type* ownedbuf = NULL;
+    datatype->createTypeBuffer(ownedbuf, ownedCount);
+    int ownedPos = 0;
+    for(int i = 0; i < count; ++i) {
+      if(commRank == owners[i]) {
+        datatype->copy(const_cast<typename DATATYPE::Type*>(sendbufOwner), i, ownedbuf, ownedPos, 1);
+        ownedPos += 1;
+      }
+    }
+
+    typename DATATYPE::Type* tempbuf = NULL;
+    if(-1 == root || root == commRank) {
+      datatype->createTypeBuffer(tempbuf, count);
+    }
+
+    int rValue;
+    if(-1 == root) {
+      rValue = AMPI_Allgatherv<DATATYPE, DATATYPE>(ownedbuf, ownedCount, datatype, tempbuf, recvcounts, displs, datatype, comm);
+    } else {
+      rValue = AMPI_Gatherv<DATATYPE, DATATYPE>(ownedbuf, ownedCount, datatype, tempbuf, recvcounts, displs, datatype, root, comm);
+    }
+
+    // sort the received values into the result buffer
+    if(-1 == root || root == commRank) {
+      for(int i = 0; i < count; ++i) {
+        datatype->copy(tempbuf, displs[owners[i]], recvbuf, i, 1);
+        displs[owners[i]] += 1;
+      }
+
+      datatype->deleteTypeBuffer(tempbuf, count);
+    }
+    datatype->deleteTypeBuffer(ownedbuf, ownedCount);
+
+    delete [] displs;
+    delete [] recvcounts;
+    delete [] owners;
+
+    return rValue;
+  }
+
   template<typename DATATYPE>
   inline int IgatherAndPerformOperationLocal_finish(HandleBase* handle) {
 
@@ -279,6 +405,9 @@ namespace medi {
         // just perfrom the normal call
         return AMPI_Reduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, root, comm);
       }
+    } else if(convOp.hasOwner && count == datatype->computeActiveElements(count)) {
+      // gather the values only from the ranks that provide them
+      return GatherFromOwners(sendbuf, recvbuf, count, datatype, convOp, root, comm);
     } else {
       // perform a gather and apply the operator locally
       return GatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, root, comm, getCommSize(comm));
@@ -330,6 +459,9 @@ namespace medi {
 
     if(convOp.hasAdjoint || !datatype->getADTool().isActiveType()) {
       return AMPI_Allreduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, comm);
+    } else if(convOp.hasOwner && count == datatype->computeActiveElements(count)) {
+      // gather the values only from the ranks that provide them
+      return GatherFromOwners(sendbuf, recvbuf, count, datatype, convOp, -1, comm);
     } else {
       // perform a gather and apply the operator locally
       return GatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, -1, comm, getCommSize(comm));
@@ -348,6 +480,206 @@ namespace medi {
     }
   }
 
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  inline int AMPI_Reduce_scatter(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(!datatype->getADTool().isActiveType()) {
+      return MPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype->getMpiType(), convOp.primalFunction, comm);
+    }
+
+    int commSize = getCommSize(comm);
+    int commRank = getCommRank(comm);
+    int totalSize = computeDisplacementsTotalSize(recvcounts, commSize);
+    int* displs = createLinearDisplacements(recvcounts, commSize);
+
+    int result;
+    if(convOp.hasAdjoint && !convOp.requiresPrimal && datatype->getADTool().isSumOperator(convOp)) {
+      // the adjoint is an allgatherv of the received adjoints
+      typename DATATYPE::Type* tempbuf = const_cast<typename DATATYPE::Type*>(sendbuf);
+      if(AMPI_IN_PLACE == sendbuf) {
+        datatype->createTypeBuffer(tempbuf, totalSize);
+        datatype->copy(recvbuf, 0, tempbuf, 0, totalSize);
+      }
+      result = AMPI_Reduce_scatter_wrap<DATATYPE>(tempbuf, recvbuf, recvcounts, displs, recvcounts[commRank], datatype, convOp, comm);
+      if(AMPI_IN_PLACE == sendbuf) {
+        datatype->deleteTypeBuffer(tempbuf, totalSize);
+      }
+    } else {
+      // reduce the full buffer on all ranks and extract the own block
+      MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufReduce = sendbuf;
+      if(AMPI_IN_PLACE == sendbuf) {
+        sendbufReduce = recvbuf;
+      }
+      typename DATATYPE::Type* tempbuf = NULL;
+      datatype->createTypeBuffer(tempbuf, totalSize);
+      result = AMPI_Allreduce<DATATYPE>(sendbufReduce, tempbuf, totalSize, datatype, convOp, comm);
+      datatype->copy(tempbuf, displs[commRank], recvbuf, 0, recvcounts[commRank]);
+      datatype->deleteTypeBuffer(tempbuf, totalSize);
+    }
+
+    delete [] displs;
+
+    return result;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  inline int AMPI_Reduce_scatter_block(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    if(!datatype->getADTool().isActiveType()) {
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      return MPI_Reduce_scatter_block(sendbuf, recvbuf, recvcount, datatype->getMpiType(), convOp.primalFunction, comm);
+    }
+
+    int commSize = getCommSize(comm);
+    int* recvcounts = new int[commSize];
+    for(int i = 0; i < commSize; ++i) {
+      recvcounts[i] = recvcount;
+    }
+
+    int result = AMPI_Reduce_scatter<DATATYPE>(sendbuf, recvbuf, recvcounts, datatype, op, comm);
+
+    delete [] recvcounts;
+
+    return result;
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_modified_Handle : public AsyncHandle {
+      typename DATATYPE::Type* tempBuf;
+      int tempBufSize;
+      bool extractBlock;
+      typename DATATYPE::Type* recvbuf;
+      int* recvcountsOwned;
+      int* displs;
+      DATATYPE* datatype;
+      AMPI_Comm comm;
+
+      HandleBase* origHandle;
+      ContinueFunction origFunc;
+  };
+
+  template<typename DATATYPE>
+  inline int AMPI_Ireduce_scatter_modified_finish(HandleBase* handle) {
+
+    AMPI_Ireduce_scatter_modified_Handle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_modified_Handle<DATATYPE>*>(handle);
+    // first call the orignal function
+    h->origFunc(h->origHandle);
+
+    if(h->extractBlock) {
+      int commRank = getCommRank(h->comm);
+      int count = h->displs[commRank + 1] - h->displs[commRank];
+      h->datatype->copy(h->tempBuf, h->displs[commRank], h->recvbuf, 0, count);
+    }
+
+    if(NULL != h->tempBuf) {
+      h->datatype->deleteTypeBuffer(h->tempBuf, h->tempBufSize);
+    }
+    if(NULL != h->recvcountsOwned) {
+      delete [] h->recvcountsOwned;
+    }
+    delete [] h->displs;
+
+    delete h;
+
+    return 0;
+  }
+
+  /**
+   * @brief Implementation of AMPI_Ireduce_scatter and AMPI_Ireduce_scatter_block.
+   *
+   * @param[in] recvcountsOwned  Array that is deleted when the request is finished. Can be NULL.
+   */
+  template<typename DATATYPE>
+  inline int IreduceScatterImpl(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, int* recvcountsOwned, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    int commSize = getCommSize(comm);
+    int commRank = getCommRank(comm);
+    int totalSize = computeDisplacementsTotalSize(recvcounts, commSize);
+
+    // one additional entry so that the own count can be recovered in the finish function
+    int* displs = new int[commSize + 1];
+    displs[0] = 0;
+    for(int i = 0; i < commSize; ++i) {
+      displs[i + 1] = displs[i] + recvcounts[i];
+    }
+
+    int result;
+    typename DATATYPE::Type* tempbuf = NULL;
+    bool extractBlock;
+    if(convOp.hasAdjoint && !convOp.requiresPrimal && datatype->getADTool().isSumOperator(convOp)) {
+      // the adjoint is an allgatherv of the received adjoints
+      extractBlock = false;
+      MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufMod = sendbuf;
+      if(AMPI_IN_PLACE == sendbuf) {
+        datatype->createTypeBuffer(tempbuf, totalSize);
+        datatype->copy(recvbuf, 0, tempbuf, 0, totalSize);
+        sendbufMod = tempbuf;
+      }
+      result = AMPI_Ireduce_scatter_wrap<DATATYPE>(sendbufMod, recvbuf, recvcounts, displs, recvcounts[commRank], datatype, convOp, comm, request);
+    } else {
+      // reduce the full buffer on all ranks and extract the own block
+      extractBlock = true;
+      MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufReduce = sendbuf;
+      if(AMPI_IN_PLACE == sendbuf) {
+        sendbufReduce = recvbuf;
+      }
+      datatype->createTypeBuffer(tempbuf, totalSize);
+      result = AMPI_Iallreduce<DATATYPE>(sendbufReduce, tempbuf, totalSize, datatype, convOp, comm, request);
+    }
+
+    AMPI_Ireduce_scatter_modified_Handle<DATATYPE>* curHandle = new AMPI_Ireduce_scatter_modified_Handle<DATATYPE>();
+    curHandle->tempBuf = tempbuf;
+    curHandle->tempBufSize = totalSize;
+    curHandle->extractBlock = extractBlock;
+    curHandle->recvbuf = recvbuf;
+    curHandle->recvcountsOwned = recvcountsOwned;
+    curHandle->displs = displs;
+    curHandle->datatype = datatype;
+    curHandle->comm = comm;
+    curHandle->origHandle = request->handle;
+    curHandle->origFunc = request->func;
+    curHandle->toolHandle = request->handle->toolHandle;
+
+    // set our own handle now to the request
+    request->handle = curHandle;
+    request->func = (ContinueFunction)AMPI_Ireduce_scatter_modified_finish<DATATYPE>;
+
+    return result;
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Ireduce_scatter(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    if(!datatype->getADTool().isActiveType()) {
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      return MPI_Ireduce_scatter(sendbuf, recvbuf, recvcounts, datatype->getMpiType(), convOp.primalFunction, comm, &request->request);
+    }
+
+    return IreduceScatterImpl<DATATYPE>(sendbuf, recvbuf, recvcounts, NULL, datatype, op, comm, request);
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Ireduce_scatter_block(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    if(!datatype->getADTool().isActiveType()) {
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      return MPI_Ireduce_scatter_block(sendbuf, recvbuf, recvcount, datatype->getMpiType(), convOp.primalFunction, comm, &request->request);
+    }
+
+    int commSize = getCommSize(comm);
+    int* recvcounts = new int[commSize];
+    for(int i = 0; i < commSize; ++i) {
+      recvcounts[i] = recvcount;
+    }
+
+    return IreduceScatterImpl<DATATYPE>(sendbuf, recvbuf, recvcounts, recvcounts, datatype, op, comm, request);
+  }
+#endif
+
   template<typename DATATYPE>
   inline int AMPI_Exscan(const typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
@@ -399,6 +731,7 @@ namespace medi {
   inline void AMPI_Init_common() {
     initTypes();
     initializeOperators();
+    createShadowComm(MPI_COMM_WORLD);
   }
 
 
@@ -414,6 +747,7 @@ namespace medi {
     int result = MPI_Init_thread(argc, argv, required, provided);
 
     AMPI_Init_common();
+    startProgressThread(*provided);
 
     return result;
   }
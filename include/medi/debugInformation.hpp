@@ -43,6 +43,10 @@ namespace medi {
 #define MEDI_DebugInformation_Warning 1
 #endif
 
+/*
+ * The debug information is stored per thread. Threads that record MPI calls concurrently, e.g. with
+ * MPI_THREAD_MULTIPLE, do not overwrite the information of each other.
+ */
 
 void setDebugInformation(std::string const& info);
 std::string getDebugInformation();
@@ -30,6 +30,7 @@
 
 
 #include "macros.h"
+#include "mpiTools.h"
 
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
@@ -52,6 +53,16 @@ namespace medi {
        */
       int* counts;
 
+      /**
+       * @brief The type of the elements that are described by counts and displs.
+       */
+      MPI_Datatype type;
+
+      /**
+       * @brief True if type is a derived datatype that is freed in the destructor.
+       */
+      bool isDerived;
+
       /**
        * @brief Create displacemnts where each displacement has the size length.
        *
@@ -62,15 +73,40 @@ namespace medi {
        *
        * counts[i] = length;
        *
-       * @param[in] commSize  The size of the communication object.
-       * @param[in]   length  The length of each displacement.
+       * The counts of the v-collectives are int. If the displacements are not in the range of largeCountLimit(), one
+       * block of length elements is described by a derived datatype. The counts are then one and the displacements are
+       * the rank numbers.
+       *
+       * For the neighbors of a topology communicator that are MPI_PROC_NULL, the count is zero and no space is
+       * reserved, see isProcNullNeighbor.
+       *
+       * @param[in]     commSize  The size of the communication object.
+       * @param[in]       length  The length of each displacement.
+       * @param[in]     baseType  The type of the elements.
+       * @param[in] neighborComm  The topology communicator of a neighborhood collective or MPI_COMM_NULL.
        */
-      inline LinearDisplacements(int commSize, int length) {
+      inline LinearDisplacements(int commSize, LargeCount length, MPI_Datatype baseType,
+                                 MPI_Comm neighborComm = MPI_COMM_NULL) :
+        type(baseType),
+        isDerived(isLargeCount((LargeCount)commSize * length)) {
+        int blockLength = (int)length;
+        if(isDerived) {
+          LargeCountType blockType(length, baseType);
+          MPI_Type_contiguous(blockType.count, blockType.type, &type);
+          MPI_Type_commit(&type);
+          blockLength = 1;
+        }
+
         counts = new int[commSize];
         displs = new int[commSize];
+        int pos = 0;
         for(int i = 0; i < commSize; ++i) {
-          counts[i] = length;
-          displs[i] = i * length;
+          counts[i] = blockLength;
+          if(MPI_COMM_NULL != neighborComm && isProcNullNeighbor(neighborComm, i)) {
+            counts[i] = 0;
+          }
+          displs[i] = pos;
+          pos += counts[i];
         }
       }
 
@@ -80,6 +116,9 @@ namespace medi {
       inline ~LinearDisplacements() {
         delete [] displs;
         delete [] counts;
+        if(isDerived) {
+          MPI_Type_free(&type);
+        }
       }
 
       /**
@@ -94,6 +133,49 @@ namespace medi {
       }
   };
 
+  /**
+   * @brief The linear displacements of the send and receive buffer of a neighborhood collective.
+   *
+   * The blocks of the neighbors that are MPI_PROC_NULL are left out, see LinearDisplacements.
+   */
+  struct NeighborDisplacements {
+
+      /**
+       * @brief The displacements of the send buffer, one block for each destination neighbor.
+       */
+      LinearDisplacements send;
+
+      /**
+       * @brief The displacements of the receive buffer, one block for each source neighbor.
+       */
+      LinearDisplacements recv;
+
+      /**
+       * @brief Create the displacements for a neighborhood collective.
+       *
+       * @param[in]       comm  The communicator of the neighborhood collective.
+       * @param[in] sendLength  The length of each send block.
+       * @param[in]   sendType  The type of the send elements.
+       * @param[in] recvLength  The length of each receive block.
+       * @param[in]   recvType  The type of the receive elements.
+       */
+      inline NeighborDisplacements(MPI_Comm comm, LargeCount sendLength, MPI_Datatype sendType, LargeCount recvLength,
+                                   MPI_Datatype recvType) :
+        send(getCommOutDegree(comm), sendLength, sendType, comm),
+        recv(getCommInDegree(comm), recvLength, recvType, comm) {}
+
+      /**
+       * @brief Helper function for deleting a NeighborDisplacements structure.
+       *
+       * @param[in] d  The pointer to a NeighborDisplacements structure that will be deleted.
+       */
+      static inline void deleteFunc(void* d) {
+        NeighborDisplacements* data = reinterpret_cast<NeighborDisplacements*>(d);
+
+        delete data;
+      }
+  };
+
   /**
    * @brief Compute the total size of a message that has a different size on each rank.
    *
@@ -133,26 +215,99 @@ namespace medi {
   /**
    * @brief Creates the linearized displacements of a message with a different size on each rank.
    *
-   * The counts are scaled by the given factor.
+   * The counts and displacements are given in active elements. In the vector mode, the MPI calls use a VectorType
+   * for the elements.
    *
    * @param[in] countsOut  The generated counts.
    * @param[in] displsOut  The generated displacements.
    * @param[in]    counts  The size of each rank.
    * @param[in]     ranks  The number of the ranks.
-   * @param[in]     scale  The scaling factor of the counts and displacements.
    */
-  inline void createLinearDisplacementsAndCount(int* &countsOut, int* &displsOut, const int* counts, int ranks, int scale) {
+  inline void createLinearDisplacementsAndCount(int* &countsOut, int* &displsOut, const int* counts, int ranks) {
     displsOut = new int[ranks];
     countsOut = new int[ranks];
 
-    countsOut[0] = counts[0] * scale;
+    countsOut[0] = counts[0];
     displsOut[0] = 0;
     for(int i = 1; i < ranks; ++i) {
-      countsOut[i] = counts[i] * scale;
+      countsOut[i] = counts[i];
       displsOut[i] = countsOut[i - 1] +  displsOut[i - 1];
     }
   }
 
+  /**
+   * @brief Compute the largest count of a message that has a different size on each rank.
+   *
+   * @param[in] counts  The size of each rank.
+   * @param[in]  ranks  The number of the ranks.
+   *
+   * @return The maximum over all counts.
+   */
+  inline int computeMaxCount(const int* counts, int ranks) {
+    int maxCount = 0;
+    for(int i = 0; i < ranks; ++i) {
+      if(maxCount < counts[i]) {
+        maxCount = counts[i];
+      }
+    }
+
+    return maxCount;
+  }
+
+  /**
+   * @brief The counts of the v-collectives in values instead of vectors.
+   *
+   * The predefined reduction operations can not be used with a VectorType, the counts are therefore scaled by the
+   * vector size for them.
+   */
+  struct ScaledCounts {
+
+      /**
+       * @brief The array with the scaled counts.
+       */
+      int* counts;
+
+      /**
+       * @brief Scale the counts of all ranks.
+       *
+       * @param[in]  counts  The counts in vectors.
+       * @param[in]   ranks  The number of the ranks.
+       * @param[in]   scale  The vector size.
+       */
+      inline ScaledCounts(const int* counts, int ranks, int scale) {
+        if((LargeCount)computeMaxCount(counts, ranks) * scale > INT_MAX) {
+          MEDI_EXCEPTION("The reduction of vectors with %d values exceeds the range of int.", scale);
+        }
+
+        this->counts = new int[ranks];
+        for(int i = 0; i < ranks; ++i) {
+          this->counts[i] = counts[i] * scale;
+        }
+      }
+
+      /**
+       * @brief Destroy the structure.
+       */
+      inline ~ScaledCounts() {
+        delete [] counts;
+      }
+
+      /**
+       * @brief Helper function for deleting a ScaledCounts structure.
+       *
+       * @param[in] d  The pointer to a ScaledCounts structure that will be deleted.
+       */
+      static inline void deleteFunc(void* d) {
+        ScaledCounts* data = reinterpret_cast<ScaledCounts*>(d);
+
+        delete data;
+      }
+
+    private:
+      ScaledCounts(const ScaledCounts&) = delete;
+      ScaledCounts& operator=(const ScaledCounts&) = delete;
+  };
+
   /**
    * @brief Creates the counts for a message with a different size on each rank.
    *
@@ -178,4 +333,21 @@ namespace medi {
       lastSum = curSum;
     }
   }
+
+  /**
+   * @brief Set the counts of the neighbors that are MPI_PROC_NULL to zero.
+   *
+   * MeDiPack stores no AD data for these neighbors, the linear displacements of the counts leave them out.
+   *
+   * @param[in,out] counts  The counts for each neighbor.
+   * @param[in]       comm  The communicator of the neighborhood collective.
+   * @param[in]      ranks  The number of neighbors in counts.
+   */
+  inline void clearProcNullNeighborCounts(int* counts, MPI_Comm comm, int ranks) {
+    for(int i = 0; i < ranks; ++i) {
+      if(isProcNullNeighbor(comm, i)) {
+        counts[i] = 0;
+      }
+    }
+  }
 }
@@ -29,7 +29,10 @@
 #pragma once
 
 #include "../ampi/async.hpp"
+#include "../ampi/deferredReverse.hpp"
 #include "../ampi/message.hpp"
+#include "../ampi/progressThread.hpp"
+#include "../ampi/reversePrefetch.hpp"
 #include "../ampi/reverseFunctions.hpp"
 #include "../ampi/forwardFunctions.hpp"
 #include "../ampi/primalFunctions.hpp"
@@ -48,7 +51,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -75,7 +78,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -93,7 +96,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -111,16 +114,26 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
-    AMPI_Bsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    if(!receivePrefetchedAdjoints(handle, h->bufAdjoints, adjointInterface)) {
+      AMPI_Bsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    }
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
+  template<typename DATATYPE>
+  bool AMPI_Bsend_prefetch(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Bsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bsend_AdjointHandle<DATATYPE>*>(handle);
+
+    return prefetchAdjointRecv(handle, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                               h->datatype->getADTool().getAdjointMpiType(), h->dest, h->tag, h->comm, adjointInterface);
+  }
+
   template<typename DATATYPE>
   int AMPI_Bsend(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int tag,
                  AMPI_Comm comm) {
@@ -173,6 +186,7 @@ namespace medi {
         h->funcReverse = AMPI_Bsend_b<DATATYPE>;
         h->funcForward = AMPI_Bsend_d<DATATYPE>;
         h->funcPrimal = AMPI_Bsend_p<DATATYPE>;
+        h->funcPrefetch = AMPI_Bsend_prefetch<DATATYPE>;
         h->count = count;
         h->datatype = datatype;
         h->dest = dest;
@@ -210,7 +224,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -248,7 +262,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -265,7 +279,7 @@ namespace medi {
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -277,7 +291,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -294,7 +308,7 @@ namespace medi {
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -306,7 +320,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Ibsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -320,7 +334,7 @@ namespace medi {
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -700,7 +714,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     AMPI_Message message;
@@ -740,7 +754,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
 
     AMPI_Imrecv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, &h->message, &h->requestReverse,
@@ -754,7 +768,7 @@ namespace medi {
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
@@ -771,7 +785,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Imrecv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, &h->message, &h->requestReverse,
@@ -785,7 +799,7 @@ namespace medi {
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -799,7 +813,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -819,7 +833,7 @@ namespace medi {
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -975,7 +989,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int source;
@@ -1019,7 +1033,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
 
     AMPI_Irecv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm,
@@ -1033,7 +1047,7 @@ namespace medi {
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
@@ -1050,7 +1064,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Irecv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm,
@@ -1064,7 +1078,7 @@ namespace medi {
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1078,7 +1092,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1098,7 +1112,7 @@ namespace medi {
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1261,7 +1275,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -1299,7 +1313,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -1316,7 +1330,7 @@ namespace medi {
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1328,7 +1342,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1345,7 +1359,7 @@ namespace medi {
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1357,7 +1371,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Irsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1371,7 +1385,7 @@ namespace medi {
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1522,7 +1536,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -1560,7 +1574,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -1577,7 +1591,7 @@ namespace medi {
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1589,7 +1603,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1606,7 +1620,7 @@ namespace medi {
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1618,7 +1632,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Isend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1632,7 +1646,7 @@ namespace medi {
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1783,7 +1797,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -1821,7 +1835,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -1838,7 +1852,7 @@ namespace medi {
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1850,7 +1864,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -1867,7 +1881,7 @@ namespace medi {
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1879,7 +1893,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Issend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1893,7 +1907,7 @@ namespace medi {
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -2045,7 +2059,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     AMPI_Message message;
@@ -2076,7 +2090,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
 
     AMPI_Mrecv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, &h->message, h->status, h->reverse_send);
@@ -2096,7 +2110,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Mrecv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, &h->message, h->status,
@@ -2114,7 +2128,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -2229,7 +2243,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int source;
@@ -2262,7 +2276,7 @@ namespace medi {
 
     MPI_Status status;
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
 
     AMPI_Recv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm, &status,
@@ -2284,7 +2298,7 @@ namespace medi {
 
     MPI_Status status;
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
     AMPI_Recv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm, &status,
@@ -2301,9 +2315,19 @@ namespace medi {
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
 
+    if(isPipelinedReverse(h->bufIndices, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                          h->comm, adjointInterface)) {
+      if(adType->isOldPrimalsRequired()) {
+        adjointInterface->setPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+      }
+      pipelinedAdjointSend(h->bufIndices, h->bufTotalSize, h->datatype->getADTool().getAdjointMpiType(), h->source,
+                           h->tag, h->comm, adjointInterface);
+      return;
+    }
+
     MPI_Status status;
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -2665,7 +2689,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -2692,7 +2716,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -2710,7 +2734,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -2728,16 +2752,26 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
-    AMPI_Rsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    if(!receivePrefetchedAdjoints(handle, h->bufAdjoints, adjointInterface)) {
+      AMPI_Rsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    }
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
+  template<typename DATATYPE>
+  bool AMPI_Rsend_prefetch(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Rsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Rsend_AdjointHandle<DATATYPE>*>(handle);
+
+    return prefetchAdjointRecv(handle, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                               h->datatype->getADTool().getAdjointMpiType(), h->dest, h->tag, h->comm, adjointInterface);
+  }
+
   template<typename DATATYPE>
   int AMPI_Rsend(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int tag,
                  AMPI_Comm comm) {
@@ -2790,6 +2824,7 @@ namespace medi {
         h->funcReverse = AMPI_Rsend_b<DATATYPE>;
         h->funcForward = AMPI_Rsend_d<DATATYPE>;
         h->funcPrimal = AMPI_Rsend_p<DATATYPE>;
+        h->funcPrefetch = AMPI_Rsend_prefetch<DATATYPE>;
         h->count = count;
         h->datatype = datatype;
         h->dest = dest;
@@ -3055,7 +3090,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -3082,7 +3117,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -3100,7 +3135,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -3117,17 +3152,34 @@ namespace medi {
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
 
+    if(isPipelinedReverse(h->bufIndices, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                          h->comm, adjointInterface)) {
+      pipelinedAdjointRecv(h->bufIndices, h->bufTotalSize, h->datatype->getADTool().getAdjointMpiType(), h->dest, h->tag,
+                           h->comm, adjointInterface);
+      return;
+    }
+
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
-    AMPI_Send_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    if(!receivePrefetchedAdjoints(handle, h->bufAdjoints, adjointInterface)) {
+      AMPI_Send_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    }
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
+  template<typename DATATYPE>
+  bool AMPI_Send_prefetch(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Send_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Send_AdjointHandle<DATATYPE>*>(handle);
+
+    return prefetchAdjointRecv(handle, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                               h->datatype->getADTool().getAdjointMpiType(), h->dest, h->tag, h->comm, adjointInterface);
+  }
+
   template<typename DATATYPE>
   int AMPI_Send(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int tag,
                 AMPI_Comm comm) {
@@ -3180,6 +3232,7 @@ namespace medi {
         h->funcReverse = AMPI_Send_b<DATATYPE>;
         h->funcForward = AMPI_Send_d<DATATYPE>;
         h->funcPrimal = AMPI_Send_p<DATATYPE>;
+        h->funcPrefetch = AMPI_Send_prefetch<DATATYPE>;
         h->count = count;
         h->datatype = datatype;
         h->dest = dest;
@@ -3445,7 +3498,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int dest;
@@ -3456,7 +3509,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     int source;
@@ -3497,10 +3550,10 @@ namespace medi {
 
     MPI_Status status;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -3527,10 +3580,10 @@ namespace medi {
 
     MPI_Status status;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -3554,7 +3607,7 @@ namespace medi {
 
     MPI_Status status;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -3563,7 +3616,7 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
     AMPI_Sendrecv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype, h->dest,
@@ -3702,7 +3755,7 @@ namespace medi {
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
-    int bufCountVec;
+    LargeCount bufCountVec;
     int count;
     DATATYPE* datatype;
     int dest;
@@ -3729,7 +3782,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
@@ -3747,7 +3800,7 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
@@ -3765,16 +3818,26 @@ namespace medi {
     (void)adType;
 
     h->bufAdjoints = nullptr;
-    h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
+    h->bufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
 
-    AMPI_Ssend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    if(!receivePrefetchedAdjoints(handle, h->bufAdjoints, adjointInterface)) {
+      AMPI_Ssend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
+    }
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
+  template<typename DATATYPE>
+  bool AMPI_Ssend_prefetch(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ssend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ssend_AdjointHandle<DATATYPE>*>(handle);
+
+    return prefetchAdjointRecv(handle, (LargeCount)adjointInterface->getVectorSize() * h->bufCount, h->bufTotalSize,
+                               h->datatype->getADTool().getAdjointMpiType(), h->dest, h->tag, h->comm, adjointInterface);
+  }
+
   template<typename DATATYPE>
   int AMPI_Ssend(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int tag,
                  AMPI_Comm comm) {
@@ -3827,6 +3890,7 @@ namespace medi {
         h->funcReverse = AMPI_Ssend_b<DATATYPE>;
         h->funcForward = AMPI_Ssend_d<DATATYPE>;
         h->funcPrimal = AMPI_Ssend_p<DATATYPE>;
+        h->funcPrefetch = AMPI_Ssend_prefetch<DATATYPE>;
         h->count = count;
         h->datatype = datatype;
         h->dest = dest;
@@ -4092,7 +4156,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -4101,7 +4165,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
@@ -4139,10 +4203,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -4168,10 +4232,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -4186,6 +4250,9 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Allgather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
@@ -4194,7 +4261,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -4203,13 +4270,36 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointRankBlocks(adType, h->sendbufCountVec, h->comm));
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Allgather_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Iallgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                              h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype,
+                                              h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
+    AMPI_Allgather_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointRankBlocks(adType, h->sendbufCountVec, h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
@@ -4354,7 +4444,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -4407,11 +4497,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -4439,18 +4528,17 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
+                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
@@ -4460,6 +4548,9 @@ namespace medi {
     delete [] h->recvbufDisplsVec;
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Allgatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
@@ -4468,8 +4559,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -4478,13 +4568,36 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointRankBlocks(adType, (LargeCount)adjointInterface->getVectorSize() * computeMaxCount(h->recvbufCount, getCommSize(h->comm)), h->comm));
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Allgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Iallgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                               h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(),
+                                               h->recvcounts, h->displs, h->recvtype, h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
+                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm);
+    AMPI_Allgatherv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointRankBlocks(adType, (LargeCount)adjointInterface->getVectorSize() * computeMaxCount(h->recvbufCount, getCommSize(h->comm)), h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
@@ -4661,14 +4774,14 @@ namespace medi {
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int count;
     DATATYPE* datatype;
     AMPI_Op op;
@@ -4708,10 +4821,10 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -4738,17 +4851,17 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Allreduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                        h->count, h->datatype, h->op, h->comm);
+                                        h->count, h->datatype, h->op, h->comm, adjointInterface);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
@@ -4756,6 +4869,9 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
+  template<typename DATATYPE>
+  void AMPI_Allreduce_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename DATATYPE>
   void AMPI_Allreduce_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Allreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Allreduce_global_AdjointHandle<DATATYPE>*>(handle);
@@ -4765,7 +4881,7 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -4775,13 +4891,37 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getHierarchicalRankBlocks(adType, h->comm));
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Allreduce_global_b_finish<DATATYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Iallreduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints,
+                                           h->recvbufCountVec, h->count, h->datatype, h->op, h->comm,
+                                           &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Allreduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                         h->count, h->datatype, h->op, h->comm);
+    AMPI_Allreduce_global_b_finish<DATATYPE>(handle, adjointInterface);
+  }
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+  template<typename DATATYPE>
+  void AMPI_Allreduce_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Allreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Allreduce_global_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getHierarchicalRankBlocks(adType, h->comm));
     // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
     // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
     convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
@@ -4944,7 +5084,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -4953,7 +5093,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
@@ -4991,10 +5131,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -5020,10 +5160,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -5038,6 +5178,9 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Alltoall_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
@@ -5046,7 +5189,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -5055,11 +5198,34 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Alltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ialltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                             h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm,
+                                             &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
                                           h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
+    AMPI_Alltoall_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -5221,6 +5387,7 @@ namespace medi {
     MEDI_OPTIONAL_CONST  int* rdispls;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
+    bool reverseSparse;
 
     ~AMPI_Alltoallv_AdjointHandle () {
       if(nullptr != sendbufIndices) {
@@ -5263,12 +5430,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -5276,7 +5441,7 @@ namespace medi {
 
     AMPI_Alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
                                            h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                           h->recvtype, h->comm);
+                                           h->recvtype, h->comm, h->reverseSparse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     delete [] h->sendbufCountVec;
@@ -5299,20 +5464,18 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
-    AMPI_Alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                           h->recvtype, h->comm);
+    AMPI_Alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                           h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                           h->recvtype, h->comm, h->reverseSparse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     delete [] h->sendbufCountVec;
@@ -5324,6 +5487,9 @@ namespace medi {
     delete [] h->recvbufDisplsVec;
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Alltoallv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
@@ -5332,8 +5498,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -5342,13 +5507,36 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                           h->recvtype, h->comm);
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Alltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ialltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                              h->sendcounts, h->sdispls, h->sendtype, h->recvbufAdjoints,
+                                              h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                              h->recvtype, h->comm, &deferred->request, h->reverseSparse);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
+    AMPI_Alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                           h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                           h->recvtype, h->comm, h->reverseSparse);
+    AMPI_Alltoallv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -5486,6 +5674,7 @@ namespace medi {
         h->rdispls = rdispls;
         h->recvtype = recvtype;
         h->comm = comm;
+        h->reverseSparse = isSparseAlltoallv(comm);
       }
 
       if(!recvtype->isModifiedBufferRequired()) {
@@ -5541,14 +5730,14 @@ namespace medi {
     typename DATATYPE::PrimalType* bufferSendPrimals;
     /* required for async */ void* bufferSendAdjoints;
     int bufferSendCount;
-    int bufferSendCountVec;
+    LargeCount bufferSendCountVec;
     int bufferRecvTotalSize;
     typename DATATYPE::IndexType* bufferRecvIndices;
     typename DATATYPE::PrimalType* bufferRecvPrimals;
     typename DATATYPE::PrimalType* bufferRecvOldPrimals;
     /* required for async */ void* bufferRecvAdjoints;
     int bufferRecvCount;
-    int bufferRecvCountVec;
+    LargeCount bufferRecvCountVec;
     int count;
     DATATYPE* datatype;
     int root;
@@ -5586,11 +5775,11 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufferRecvPrimals, h->bufferRecvTotalSize );
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->bufferSendPrimals, h->bufferSendTotalSize );
       // Primal buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getPrimals(h->bufferSendIndices, h->bufferSendPrimals, h->bufferSendTotalSize);
@@ -5618,11 +5807,11 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
@@ -5640,6 +5829,9 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->bufferRecvAdjoints);
   }
 
+  template<typename DATATYPE>
+  void AMPI_Bcast_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename DATATYPE>
   void AMPI_Bcast_wrap_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Bcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bcast_wrap_AdjointHandle<DATATYPE>*>(handle);
@@ -5647,7 +5839,7 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
@@ -5657,15 +5849,36 @@ namespace medi {
     }
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
-      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize * getCommSize(h->comm));
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
+      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize * getHierarchicalRankBlocks(adType, h->comm));
     }
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle, AMPI_Bcast_wrap_b_finish<DATATYPE>,
+                                                                          h->bufferSendIndices, h->bufferSendTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ibcast_wrap_adj<DATATYPE>(h->bufferSendAdjoints, h->bufferSendCountVec, h->bufferRecvAdjoints,
+                                     h->bufferRecvCountVec, h->count, h->datatype, h->root, h->comm,
+                                     &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Bcast_wrap_adj<DATATYPE>(h->bufferSendAdjoints, h->bufferSendCountVec, h->bufferRecvAdjoints,
                                   h->bufferRecvCountVec, h->count, h->datatype, h->root, h->comm);
+    AMPI_Bcast_wrap_b_finish<DATATYPE>(handle, adjointInterface);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Bcast_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Bcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Bcast_wrap_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
 
     if(h->root == getCommRank(h->comm)) {
-      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getCommSize(h->comm));
+      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getHierarchicalRankBlocks(adType, h->comm));
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->updateAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
@@ -5818,7 +6031,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -5827,7 +6040,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     int root;
@@ -5866,11 +6079,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -5900,11 +6113,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -5921,6 +6134,9 @@ namespace medi {
     }
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Gather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Gather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
@@ -5929,7 +6145,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -5941,11 +6157,33 @@ namespace medi {
       }
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Gather_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Igather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                           h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root,
+                                           h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Gather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Gather_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Gather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -6113,7 +6351,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -6168,12 +6406,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -6206,19 +6443,18 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Gatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
@@ -6230,6 +6466,9 @@ namespace medi {
     }
   }
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Gatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
   template<typename SENDTYPE, typename RECVTYPE>
   void AMPI_Gatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
     AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
@@ -6239,8 +6478,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -6252,11 +6490,34 @@ namespace medi {
       }
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Gatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Igatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts,
+                                            h->displs, h->recvtype, h->root, h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
     AMPI_Gatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
+    AMPI_Gatherv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Gatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -6455,7 +6716,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -6464,7 +6725,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
@@ -6515,10 +6776,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -6536,7 +6797,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
@@ -6555,10 +6816,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -6576,7 +6837,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
@@ -6592,7 +6853,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -6601,8 +6862,8 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointRankBlocks(adType, h->sendbufCountVec, h->comm));
 
     AMPI_Iallgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
                                             h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
@@ -6616,9 +6877,9 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointRankBlocks(adType, h->sendbufCountVec, h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
@@ -6827,7 +7088,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -6895,11 +7156,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -6918,7 +7178,7 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
@@ -6939,18 +7199,17 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Iallgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-        h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+        h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm,
         &h->requestReverse);
 
   }
@@ -6962,7 +7221,7 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
@@ -6980,8 +7239,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -6990,11 +7248,11 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointRankBlocks(adType, (LargeCount)adjointInterface->getVectorSize() * computeMaxCount(h->recvbufCount, getCommSize(h->comm)), h->comm));
 
     AMPI_Iallgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-        h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+        h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm,
         &h->requestReverse);
 
   }
@@ -7006,9 +7264,9 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointRankBlocks(adType, (LargeCount)adjointInterface->getVectorSize() * computeMaxCount(h->recvbufCount, getCommSize(h->comm)), h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
@@ -7254,14 +7512,14 @@ namespace medi {
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int count;
     DATATYPE* datatype;
     AMPI_Op op;
@@ -7314,10 +7572,10 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -7335,7 +7593,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -7358,17 +7616,17 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Iallreduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                         h->count, h->datatype, h->op, h->comm, &h->requestReverse);
+                                         h->count, h->datatype, h->op, h->comm, &h->requestReverse, adjointInterface);
 
   }
 
@@ -7379,7 +7637,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -7399,7 +7657,7 @@ namespace medi {
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -7409,7 +7667,7 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
 
     AMPI_Iallreduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
@@ -7424,7 +7682,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -7654,7 +7912,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -7663,7 +7921,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
@@ -7714,10 +7972,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -7735,7 +7993,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
@@ -7754,10 +8012,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -7775,7 +8033,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
@@ -7791,7 +8049,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -7800,7 +8058,7 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
     AMPI_Ialltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -7815,7 +8073,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -8041,6 +8299,7 @@ namespace medi {
     const  int* rdispls;
     RECVTYPE* recvtype;
     AMPI_Comm comm;
+    bool reverseSparse;
 
     ~AMPI_Ialltoallv_AdjointHandle () {
       if(nullptr != sendbufIndices) {
@@ -8100,12 +8359,10 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -8113,7 +8370,7 @@ namespace medi {
 
     AMPI_Ialltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
                                             h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                            h->recvtype, h->comm, &h->requestReverse);
+                                            h->recvtype, h->comm, &h->requestReverse, h->reverseSparse);
 
   }
 
@@ -8124,7 +8381,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     delete [] h->sendbufCountVec;
@@ -8147,20 +8404,18 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
-    AMPI_Ialltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                            h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                            h->recvtype, h->comm, &h->requestReverse);
+    AMPI_Ialltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                            h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                            h->recvtype, h->comm, &h->requestReverse, h->reverseSparse);
 
   }
 
@@ -8171,7 +8426,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     delete [] h->sendbufCountVec;
@@ -8191,8 +8446,7 @@ namespace medi {
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -8201,13 +8455,12 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                      adjointInterface->getVectorSize());
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Ialltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                            h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
-                                            h->recvtype, h->comm, &h->requestReverse);
+    AMPI_Ialltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                            h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                            h->recvtype, h->comm, &h->requestReverse, h->reverseSparse);
 
   }
 
@@ -8218,7 +8471,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -8358,6 +8611,7 @@ namespace medi {
         h->rdispls = rdispls;
         h->recvtype = recvtype;
         h->comm = comm;
+        h->reverseSparse = isSparseAlltoallv(comm);
       }
 
       if(!recvtype->isModifiedBufferRequired()) {
@@ -8486,14 +8740,14 @@ namespace medi {
     typename DATATYPE::PrimalType* bufferSendPrimals;
     /* required for async */ void* bufferSendAdjoints;
     int bufferSendCount;
-    int bufferSendCountVec;
+    LargeCount bufferSendCountVec;
     int bufferRecvTotalSize;
     typename DATATYPE::IndexType* bufferRecvIndices;
     typename DATATYPE::PrimalType* bufferRecvPrimals;
     typename DATATYPE::PrimalType* bufferRecvOldPrimals;
     /* required for async */ void* bufferRecvAdjoints;
     int bufferRecvCount;
-    int bufferRecvCountVec;
+    LargeCount bufferRecvCountVec;
     int count;
     DATATYPE* datatype;
     int root;
@@ -8543,11 +8797,11 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufferRecvPrimals, h->bufferRecvTotalSize );
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->bufferSendPrimals, h->bufferSendTotalSize );
       // Primal buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getPrimals(h->bufferSendIndices, h->bufferSendPrimals, h->bufferSendTotalSize);
@@ -8565,7 +8819,7 @@ namespace medi {
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->bufferSendPrimals);
@@ -8585,11 +8839,11 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
@@ -8607,7 +8861,7 @@ namespace medi {
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
@@ -8624,7 +8878,7 @@ namespace medi {
     (void)adType;
 
     h->bufferRecvAdjoints = nullptr;
-    h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
+    h->bufferRecvCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
@@ -8634,7 +8888,7 @@ namespace medi {
     }
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
+      h->bufferSendCountVec = (LargeCount)adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize * getCommSize(h->comm));
     }
 
@@ -8649,7 +8903,7 @@ namespace medi {
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getCommSize(h->comm));
@@ -8865,7 +9119,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -8874,7 +9128,7 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     int root;
@@ -8928,11 +9182,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -8950,7 +9204,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
@@ -8974,11 +9228,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -8996,7 +9250,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
@@ -9015,7 +9269,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -9027,7 +9281,7 @@ namespace medi {
       }
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
     AMPI_Igather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -9042,7 +9296,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -9276,7 +9530,7 @@ namespace medi {
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -9347,12 +9601,11 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -9371,7 +9624,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
@@ -9397,19 +9650,18 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Igatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->root, h->comm,
                                           &h->requestReverse);
 
   }
@@ -9421,7 +9673,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
@@ -9442,8 +9694,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm));
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -9455,11 +9706,11 @@ namespace medi {
       }
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
     AMPI_Igatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->root, h->comm,
                                           &h->requestReverse);
 
   }
@@ -9471,7 +9722,7 @@ namespace medi {
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
@@ -9742,14 +9993,14 @@ namespace medi {
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int count;
     DATATYPE* datatype;
     AMPI_Op op;
@@ -9804,11 +10055,11 @@ namespace medi {
     (void)convOp;
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
@@ -9825,7 +10076,7 @@ namespace medi {
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -9852,18 +10103,18 @@ namespace medi {
     (void)convOp;
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Ireduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                      h->count, h->datatype, h->op, h->root, h->comm, &h->requestReverse);
+                                      h->count, h->datatype, h->op, h->root, h->comm, &h->requestReverse, adjointInterface);
 
   }
 
@@ -9873,7 +10124,7 @@ namespace medi {
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -9895,7 +10146,7 @@ namespace medi {
     (void)convOp;
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -9908,7 +10159,7 @@ namespace medi {
       }
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
     AMPI_Ireduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
@@ -9922,7 +10173,7 @@ namespace medi {
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
     ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = adType->convertOperator(h->op);
     (void)convOp;
@@ -10172,103 +10423,111 @@ namespace medi {
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatter_AdjointHandle : public AsyncAdjointHandle {
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_wrap_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
-    typename SENDTYPE::IndexType* sendbufIndices;
-    typename SENDTYPE::PrimalType* sendbufPrimals;
+    typename DATATYPE::IndexType* sendbufIndices;
+    typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
-    int sendbufCount;
-    int sendbufCountVec;
-    int sendcount;
-    SENDTYPE* sendtype;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
     int recvbufTotalSize;
-    typename RECVTYPE::IndexType* recvbufIndices;
-    typename RECVTYPE::PrimalType* recvbufPrimals;
-    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    typename DATATYPE::IndexType* recvbufIndices;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
+    const  int* recvcounts;
+    const  int* displs;
     int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
 
-    ~AMPI_Iscatter_AdjointHandle () {
+    ~AMPI_Ireduce_scatter_wrap_AdjointHandle () {
       if(nullptr != sendbufIndices) {
-        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
       }
       if(nullptr != sendbufPrimals) {
-        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
       if(nullptr != recvbufIndices) {
-        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
       }
       if(nullptr != recvbufPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
         recvbufPrimals = nullptr;
       }
       if(nullptr != recvbufOldPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
     }
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatter_AsyncHandle : public AsyncHandle {
-    const  typename SENDTYPE::Type* sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod;
-    int sendcount;
-    SENDTYPE* sendtype;
-    typename RECVTYPE::Type* recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod;
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_wrap_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod;
+    const int* displsMod;
+    typename DATATYPE::Type* recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod;
+    const  int* recvcounts;
+    const  int* displs;
     int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
     AMPI_Request* request;
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
 
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Iscatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+    AMPI_Ireduce_scatter_wrap_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->recvbufPrimals,
+                                            h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    }
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
@@ -10277,144 +10536,158 @@ namespace medi {
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
 
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Iscatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+    AMPI_Ireduce_scatter_wrap_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->recvbufAdjoints,
+                                            h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse, adjointInterface);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
 
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
 
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    }
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Iscatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+    AMPI_Ireduce_scatter_wrap_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->recvbufAdjoints,
+                                            h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (handle);
-    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter_finish(HandleBase* handle);
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter(const typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
-                    typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_wrap_finish(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_wrap(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                const int* recvcounts, const int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm,
+                                AMPI_Request* request) {
     int rStatus;
-    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(op);
+    (void)convOp;
 
     if(!adType->isActiveType()) {
       // call the regular function if the type is not active
-      rStatus = MPI_Iscatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
-                             comm, &request->request);
+      rStatus = MPI_Ireduce_scatter_wrap(sendbuf, recvbuf, recvcounts, displs, recvcount, datatype->getMpiType(),
+                                         convOp.primalFunction, comm, &request->request);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+        if(datatype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        }
+      }
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = sendcount * getCommSize(comm);
+      // compute the total size of the buffer
+      sendbufElements = displsTotalSize;
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
       }
-      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcount;
-      }
+      recvbufElements = recvcount;
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
-        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
       if(adType->isHandleRequired()) {
-        h = new AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+        h = new AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>();
       }
       adType->startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+      if(datatype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          datatype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], recvcounts[i]);
         }
       }
 
@@ -10422,85 +10695,74 @@ namespace medi {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          h->sendbufCount = sendtype->computeActiveElements(sendcount);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(sendcount);
-        }
-        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
-        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        createLinearIndexCounts(h->sendbufCount, recvcounts, displs, getCommSize(comm), datatype);
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            datatype->getValues(sendbuf, displs[i], h->sendbufPrimals, displsMod[i], recvcounts[i]);
+          }
+        }
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
         if(adType->isOldPrimalsRequired()) {
-          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
-          }
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
         }
 
 
-        if(root == getCommRank(comm)) {
-          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          datatype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], recvcounts[i]);
         }
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
-                                  0, sendcount);
-        }
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Iscatter_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Iscatter_d_finish<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Iscatter_p_finish<SENDTYPE, RECVTYPE>;
-        h->sendcount = sendcount;
-        h->sendtype = sendtype;
+        h->funcReverse = AMPI_Ireduce_scatter_wrap_b<DATATYPE>;
+        h->funcForward = AMPI_Ireduce_scatter_wrap_d_finish<DATATYPE>;
+        h->funcPrimal = AMPI_Ireduce_scatter_wrap_p_finish<DATATYPE>;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
         h->recvcount = recvcount;
-        h->recvtype = recvtype;
-        h->root = root;
+        h->datatype = datatype;
+        h->op = op;
         h->comm = comm;
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), sendcount);
-        }
+      if(!datatype->isModifiedBufferRequired()) {
+        datatype->clearIndices(recvbuf, 0, recvcount);
       }
 
-      rStatus = MPI_Iscatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                             recvtype->getModifiedMpiType(), root, comm, &request->request);
+      rStatus = MPI_Ireduce_scatter_wrap(sendbufMod, recvbufMod, recvcounts, displsMod, recvcount,
+                                         datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, comm, &request->request);
 
-      AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>();
+      AMPI_Ireduce_scatter_wrap_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Ireduce_scatter_wrap_AsyncHandle<DATATYPE>();
       asyncHandle->sendbuf = sendbuf;
       asyncHandle->sendbufMod = sendbufMod;
-      asyncHandle->sendcount = sendcount;
-      asyncHandle->sendtype = sendtype;
+      asyncHandle->displsMod = displsMod;
       asyncHandle->recvbuf = recvbuf;
       asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->displs = displs;
       asyncHandle->recvcount = recvcount;
-      asyncHandle->recvtype = recvtype;
-      asyncHandle->root = root;
+      asyncHandle->datatype = datatype;
+      asyncHandle->op = op;
       asyncHandle->comm = comm;
       asyncHandle->toolHandle = h;
       request->handle = asyncHandle;
-      request->func = (ContinueFunction)AMPI_Iscatter_finish<SENDTYPE, RECVTYPE>;
+      request->func = (ContinueFunction)AMPI_Ireduce_scatter_wrap_finish<DATATYPE>;
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatter_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iscatter_d<SENDTYPE, RECVTYPE>, h);
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ireduce_scatter_wrap_b_finish<DATATYPE>,
+                                           (ForwardFunction)AMPI_Ireduce_scatter_wrap_d<DATATYPE>, h);
         adType->addToolAction(waitH);
       }
     }
@@ -10508,36 +10770,38 @@ namespace medi {
     return rStatus;
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter_finish(HandleBase* handle) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_wrap_finish(HandleBase* handle) {
     int rStatus = 0;
 
-    AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
-      static_cast<AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
-    const  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
-    int sendcount = asyncHandle->sendcount;
-    SENDTYPE* sendtype = asyncHandle->sendtype;
-    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    AMPI_Ireduce_scatter_wrap_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Ireduce_scatter_wrap_AsyncHandle<DATATYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
     int recvcount = asyncHandle->recvcount;
-    RECVTYPE* recvtype = asyncHandle->recvtype;
-    int root = asyncHandle->root;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
     AMPI_Comm comm = asyncHandle->comm;
     AMPI_Request* request = asyncHandle->request;
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_wrap_AdjointHandle<DATATYPE>*>
       (asyncHandle->toolHandle);
-    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
     MEDI_UNUSED(h); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
     MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
-    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
-    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
     MEDI_UNUSED(comm); // Unused generated to ignore warnings
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
@@ -10545,36 +10809,34 @@ namespace medi {
 
     if(adType->isActiveType()) {
 
+      AMPI_Op convOp = adType->convertOperator(op);
+      (void)convOp;
       adType->addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm),
-                                           sendbufMod, sendcount * getCommRank(comm), sendcount);
-        }
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
-                                  h->recvbufOldPrimals, 0, sendcount);
-        }
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcount);
       }
 
       adType->stopAssembly(h);
+      if(datatype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
       // handle is deleted by the AD tool
@@ -10586,16 +10848,14 @@ namespace medi {
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatterv_AdjointHandle : public AsyncAdjointHandle {
+  struct AMPI_Iscatter_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
-    int* sendbufCount;
-    /* required for async */ int* sendbufCountVec;
-    /* required for async */ int* sendbufDisplsVec;
-    const  int* sendcounts;
-    const  int* displs;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
@@ -10603,13 +10863,13 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
     int root;
     AMPI_Comm comm;
 
-    ~AMPI_Iscatterv_AdjointHandle () {
+    ~AMPI_Iscatter_AdjointHandle () {
       if(nullptr != sendbufIndices) {
         sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
@@ -10618,10 +10878,6 @@ namespace medi {
         sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
-      if(nullptr != sendbufCount) {
-        delete [] sendbufCount;
-        sendbufCount = nullptr;
-      }
       if(nullptr != recvbufIndices) {
         recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
@@ -10638,12 +10894,10 @@ namespace medi {
   };
 
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatterv_AsyncHandle : public AsyncHandle {
+  struct AMPI_Iscatter_AsyncHandle : public AsyncHandle {
     const  typename SENDTYPE::Type* sendbuf;
     typename SENDTYPE::ModifiedType* sendbufMod;
-    const int* displsMod;
-    const  int* sendcounts;
-    const  int* displs;
+    int sendcount;
     SENDTYPE* sendtype;
     typename RECVTYPE::Type* recvbuf;
     typename RECVTYPE::ModifiedType* recvbufMod;
@@ -10655,44 +10909,40 @@ namespace medi {
   };
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Iscatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
       // Primal buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
 
     }
 
-    AMPI_Iscatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+    AMPI_Iscatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
 
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  void AMPI_Iscatter_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
     }
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
@@ -10703,44 +10953,40 @@ namespace medi {
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Iscatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
       adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
     }
 
-    AMPI_Iscatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+    AMPI_Iscatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
 
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  void AMPI_Iscatter_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
     }
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -10748,14 +10994,14 @@ namespace medi {
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Iscatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -10765,66 +11011,54 @@ namespace medi {
     }
     h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
       adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     }
 
-    AMPI_Iscatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+    AMPI_Iscatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
 
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  void AMPI_Iscatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
       adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
     }
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv_finish(HandleBase* handle);
+  int AMPI_Iscatter_finish(HandleBase* handle);
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv(const typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
-                     typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  int AMPI_Iscatter(const typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                    typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
     ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
 
     if(!adType->isActiveType()) {
       // call the regular function if the type is not active
-      rStatus = MPI_Iscatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
-                              root, comm, &request->request);
+      rStatus = MPI_Iscatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
+                             comm, &request->request);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      MEDI_OPTIONAL_CONST int* displsMod = displs;
-      int displsTotalSize = 0;
-      if(nullptr != displs) {
-        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
-        }
-      }
+      AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
       if(root == getCommRank(comm)) {
         // compute the total size of the buffer
-        sendbufElements = displsTotalSize;
+        sendbufElements = sendcount * getCommSize(comm);
 
         if(sendtype->isModifiedBufferRequired() ) {
           sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
@@ -10839,7 +11073,7 @@ namespace medi {
       if(AMPI_IN_PLACE != recvbuf) {
         recvbufElements = recvcount;
       } else {
-        recvbufElements = sendcounts[getCommRank(comm)];
+        recvbufElements = sendcount;
       }
 
       if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
@@ -10850,14 +11084,12 @@ namespace medi {
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
       if(adType->isHandleRequired()) {
-        h = new AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+        h = new AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       adType->startAssembly(h);
       if(root == getCommRank(comm)) {
         if(sendtype->isModifiedBufferRequired()) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
-          }
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
         }
       }
 
@@ -10866,15 +11098,14 @@ namespace medi {
 
         // create the index buffers
         if(root == getCommRank(comm)) {
-          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
           h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
           sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
         }
         if(AMPI_IN_PLACE != recvbuf) {
           h->recvbufCount = recvtype->computeActiveElements(recvcount);
         } else {
-          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
-                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
+          h->recvbufCount = sendtype->computeActiveElements(sendcount);
         }
         h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
         recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
@@ -10887,36 +11118,27 @@ namespace medi {
           if(AMPI_IN_PLACE != recvbuf) {
             recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
           } else {
-            {
-              const int rank = getCommRank(comm);
-              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
-            }
+            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
           }
         }
 
 
         if(root == getCommRank(comm)) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
-          }
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
         }
 
         if(AMPI_IN_PLACE != recvbuf) {
           recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
         } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices, 0,
-                                    sendcounts[rank]);
-          }
+          sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
+                                  0, sendcount);
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Iscatterv_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Iscatterv_d_finish<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Iscatterv_p_finish<SENDTYPE, RECVTYPE>;
-        h->sendcounts = sendcounts;
-        h->displs = displs;
+        h->funcReverse = AMPI_Iscatter_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatter_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatter_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
@@ -10928,22 +11150,17 @@ namespace medi {
         if(AMPI_IN_PLACE != recvbuf) {
           recvtype->clearIndices(recvbuf, 0, recvcount);
         } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendcounts[rank]);
-          }
+          sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), sendcount);
         }
       }
 
-      rStatus = MPI_Iscatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                              recvtype->getModifiedMpiType(), root, comm, &request->request);
+      rStatus = MPI_Iscatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                             recvtype->getModifiedMpiType(), root, comm, &request->request);
 
-      AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>();
       asyncHandle->sendbuf = sendbuf;
       asyncHandle->sendbufMod = sendbufMod;
-      asyncHandle->displsMod = displsMod;
-      asyncHandle->sendcounts = sendcounts;
-      asyncHandle->displs = displs;
+      asyncHandle->sendcount = sendcount;
       asyncHandle->sendtype = sendtype;
       asyncHandle->recvbuf = recvbuf;
       asyncHandle->recvbufMod = recvbufMod;
@@ -10953,12 +11170,12 @@ namespace medi {
       asyncHandle->comm = comm;
       asyncHandle->toolHandle = h;
       request->handle = asyncHandle;
-      request->func = (ContinueFunction)AMPI_Iscatterv_finish<SENDTYPE, RECVTYPE>;
+      request->func = (ContinueFunction)AMPI_Iscatter_finish<SENDTYPE, RECVTYPE>;
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatterv_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iscatterv_d<SENDTYPE, RECVTYPE>, h);
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatter_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Iscatter_d<SENDTYPE, RECVTYPE>, h);
         adType->addToolAction(waitH);
       }
     }
@@ -10967,16 +11184,14 @@ namespace medi {
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv_finish(HandleBase* handle) {
+  int AMPI_Iscatter_finish(HandleBase* handle) {
     int rStatus = 0;
 
-    AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
-      static_cast<AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
     const  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
     typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
-    const int* displsMod = asyncHandle->displsMod;
-    const  int* sendcounts = asyncHandle->sendcounts;
-    const  int* displs = asyncHandle->displs;
+    int sendcount = asyncHandle->sendcount;
     SENDTYPE* sendtype = asyncHandle->sendtype;
     typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
     typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
@@ -10985,15 +11200,13 @@ namespace medi {
     int root = asyncHandle->root;
     AMPI_Comm comm = asyncHandle->comm;
     AMPI_Request* request = asyncHandle->request;
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (asyncHandle->toolHandle);
     ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
     MEDI_UNUSED(h); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
-    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
     MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
@@ -11013,11 +11226,8 @@ namespace medi {
         if(AMPI_IN_PLACE != recvbuf) {
           recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
         } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendbufMod,
-                                             displsMod[rank], sendcounts[rank]);
-          }
+          sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm),
+                                           sendbufMod, sendcount * getCommRank(comm), sendcount);
         }
       }
 
@@ -11026,18 +11236,12 @@ namespace medi {
         if(AMPI_IN_PLACE != recvbuf) {
           recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
         } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices,
-                                    h->recvbufOldPrimals, 0, sendcounts[rank]);
-          }
+          sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
+                                  h->recvbufOldPrimals, 0, sendcount);
         }
       }
 
       adType->stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
-      }
 
       if(root == getCommRank(comm)) {
         if(sendtype->isModifiedBufferRequired() ) {
@@ -11055,215 +11259,4080 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  template<typename DATATYPE>
-  struct AMPI_Reduce_global_AdjointHandle : public HandleBase {
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatterv_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
-    typename DATATYPE::IndexType* sendbufIndices;
-    typename DATATYPE::PrimalType* sendbufPrimals;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
-    int sendbufCount;
-    int sendbufCountVec;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
     int recvbufTotalSize;
-    typename DATATYPE::IndexType* recvbufIndices;
-    typename DATATYPE::PrimalType* recvbufPrimals;
-    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
-    int count;
-    DATATYPE* datatype;
-    AMPI_Op op;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
     int root;
     AMPI_Comm comm;
 
-    ~AMPI_Reduce_global_AdjointHandle () {
+    ~AMPI_Iscatterv_AdjointHandle () {
       if(nullptr != sendbufIndices) {
-        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
       }
       if(nullptr != sendbufPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
       if(nullptr != recvbufIndices) {
-        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
       }
       if(nullptr != recvbufPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
         recvbufPrimals = nullptr;
       }
       if(nullptr != recvbufOldPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
     }
   };
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatterv_AsyncHandle : public AsyncHandle {
+    const  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* displsMod;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
-    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
-    AMPI_Op convOp = adType->convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
     }
-    h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-    // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
 
+    AMPI_Iscatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
 
-    AMPI_Reduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec, h->count,
-                                     h->datatype, h->op, h->root, h->comm);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
 
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(adType->isOldPrimalsRequired()) {
-      if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
-      }
-    }
     if(h->root == getCommRank(h->comm)) {
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
+    }
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
-    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
-    AMPI_Op convOp = adType->convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
     }
-    h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
+    AMPI_Iscatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
 
-    AMPI_Reduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                     h->count, h->datatype, h->op, h->root, h->comm);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
 
-    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
     }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
-    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
-    AMPI_Op convOp = adType->convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
 
-      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
-    }
     if(adType->isOldPrimalsRequired()) {
-      if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
-      }
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    if(h->root == getCommRank(h->comm)) {
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
 
-    AMPI_Reduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                     h->count, h->datatype, h->op, h->root, h->comm);
+    AMPI_Iscatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
 
-    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
-    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
-    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
-                                adjointInterface->getVectorSize());
-    // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
     }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename DATATYPE>
-  int AMPI_Reduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
-                         int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv(const typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
+                     typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
-    ADToolInterface const* adType = selectADTool(datatype->getADTool());
-    AMPI_Op convOp = adType->convertOperator(op);
-    (void)convOp;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
 
     if(!adType->isActiveType()) {
       // call the regular function if the type is not active
-      rStatus = MPI_Reduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, root, comm);
+      rStatus = MPI_Iscatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                              root, comm, &request->request);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = nullptr;
-      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = displsTotalSize;
+
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != sendbuf) {
-        sendbufElements = count;
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
       } else {
-        sendbufElements = count;
+        recvbufElements = sendcounts[getCommRank(comm)];
       }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
-        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
-        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
-      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
-      int recvbufElements = 0;
 
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
       if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        recvbufElements = count;
+        if(sendtype->isModifiedBufferRequired()) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+          }
+        }
+      }
 
-        if(datatype->isModifiedBufferRequired() ) {
-          datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
         } else {
-          recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
+                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
         }
-      }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
-      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(adType->isHandleRequired()) {
-        h = new AMPI_Reduce_global_AdjointHandle<DATATYPE>();
-      }
-      adType->startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != sendbuf) {
-          datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            {
+              const int rank = getCommRank(comm);
+              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+            }
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+          }
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
         } else {
-          datatype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+          {
+            const int rank = getCommRank(comm);
+            sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices, 0,
+                                    sendcounts[rank]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iscatterv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatterv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatterv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->displs = displs;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = comm;
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      rStatus = MPI_Iscatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                              recvtype->getModifiedMpiType(), root, comm, &request->request);
+
+      AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Iscatterv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatterv_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Iscatterv_d<SENDTYPE, RECVTYPE>, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    const  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* displs = asyncHandle->displs;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(adType->isActiveType()) {
+
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendbufMod,
+                                             displsMod[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices,
+                                    h->recvbufOldPrimals, 0, sendcounts[rank]);
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
+
+      if(root == getCommRank(comm)) {
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Reduce_global_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename DATATYPE::IndexType* sendbufIndices;
+    typename DATATYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int recvbufTotalSize;
+    typename DATATYPE::IndexType* recvbufIndices;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int count;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Reduce_global_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec, h->count,
+                                     h->datatype, h->op, h->root, h->comm);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      if(h->root == getCommRank(h->comm)) {
+        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+      }
+    }
+    if(h->root == getCommRank(h->comm)) {
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                     h->count, h->datatype, h->op, h->root, h->comm, adjointInterface);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    }
+    if(adType->isOldPrimalsRequired()) {
+      if(h->root == getCommRank(h->comm)) {
+        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+      }
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle, AMPI_Reduce_global_b_finish<DATATYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ireduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                        h->count, h->datatype, h->op, h->root, h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
+    AMPI_Reduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                     h->count, h->datatype, h->op, h->root, h->comm);
+    AMPI_Reduce_global_b_finish<DATATYPE>(handle, adjointInterface);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    }
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Reduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                         int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(op);
+    (void)convOp;
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Reduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, root, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = count;
+      } else {
+        sendbufElements = count;
+      }
+
+      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        recvbufElements = count;
+
+        if(datatype->isModifiedBufferRequired() ) {
+          datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+        } else {
+          recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+        }
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Reduce_global_AdjointHandle<DATATYPE>();
+      }
+      adType->startAssembly(h);
+      if(datatype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
+        } else {
+          datatype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        } else {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        }
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        if(root == getCommRank(comm)) {
+          h->recvbufCount = datatype->computeActiveElements(count);
+          h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+          datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        }
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          if(AMPI_IN_PLACE != sendbuf) {
+            datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
+          } else {
+            datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
+          }
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          if(root == getCommRank(comm)) {
+            datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+            if(root == getCommRank(comm)) {
+              datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
+            }
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
+        } else {
+          datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
+        }
+
+        if(root == getCommRank(comm)) {
+          datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Reduce_global_b<DATATYPE>;
+        h->funcForward = AMPI_Reduce_global_d<DATATYPE>;
+        h->funcPrimal = AMPI_Reduce_global_p<DATATYPE>;
+        h->count = count;
+        h->datatype = datatype;
+        h->op = op;
+        h->root = root;
+        h->comm = comm;
+      }
+
+      if(root == getCommRank(comm)) {
+        if(!datatype->isModifiedBufferRequired()) {
+          datatype->clearIndices(recvbuf, 0, count);
+        }
+      }
+
+      rStatus = MPI_Reduce(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, root,
+                           comm);
+      adType->addToolAction(h);
+
+      if(root == getCommRank(comm)) {
+        if(datatype->isModifiedBufferRequired()) {
+          datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(root == getCommRank(comm)) {
+          datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+        }
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        if(root == getCommRank(comm)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+          if(root == getCommRank(comm)) {
+            datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+
+      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(root == getCommRank(comm)) {
+        if(datatype->isModifiedBufferRequired() ) {
+          datatype->deleteModifiedTypeBuffer(recvbufMod);
+        }
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Reduce_scatter_wrap_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename DATATYPE::IndexType* sendbufIndices;
+    typename DATATYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    int recvbufTotalSize;
+    typename DATATYPE::IndexType* recvbufIndices;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    MEDI_OPTIONAL_CONST  int* recvcounts;
+    MEDI_OPTIONAL_CONST  int* displs;
+    int recvcount;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    AMPI_Comm comm;
+
+    ~AMPI_Reduce_scatter_wrap_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_scatter_wrap_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->recvbufPrimals,
+                                           h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_scatter_wrap_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->recvbufAdjoints,
+                                           h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm, adjointInterface);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Reduce_scatter_wrap_b_finish<DATATYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ireduce_scatter_wrap_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                              h->recvbufAdjoints, h->recvbufCountVec, h->recvcounts, h->displs,
+                                              h->recvcount, h->datatype, h->op, h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
+    AMPI_Reduce_scatter_wrap_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->recvbufAdjoints,
+                                           h->recvbufCountVec, h->recvcounts, h->displs, h->recvcount, h->datatype, h->op, h->comm);
+    AMPI_Reduce_scatter_wrap_b_finish<DATATYPE>(handle, adjointInterface);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->datatype->getADTool());
+    (void)adType;
+
+    AMPI_Op convOp = adType->convertOperator(h->op);
+    (void)convOp;
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_wrap(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                               MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, int recvcount, DATATYPE* datatype, AMPI_Op op,
+                               AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(datatype->getADTool());
+    AMPI_Op convOp = adType->convertOperator(op);
+    (void)convOp;
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Reduce_scatter_wrap(sendbuf, recvbuf, recvcounts, displs, recvcount, datatype->getMpiType(),
+                                        convOp.primalFunction, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+        if(datatype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        }
+      }
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = displsTotalSize;
+
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount;
+
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Reduce_scatter_wrap_AdjointHandle<DATATYPE>();
+      }
+      adType->startAssembly(h);
+      if(datatype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          datatype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], recvcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        createLinearIndexCounts(h->sendbufCount, recvcounts, displs, getCommSize(comm), datatype);
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            datatype->getValues(sendbuf, displs[i], h->sendbufPrimals, displsMod[i], recvcounts[i]);
+          }
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+        }
+
+
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          datatype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], recvcounts[i]);
+        }
+
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Reduce_scatter_wrap_b<DATATYPE>;
+        h->funcForward = AMPI_Reduce_scatter_wrap_d<DATATYPE>;
+        h->funcPrimal = AMPI_Reduce_scatter_wrap_p<DATATYPE>;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvcount = recvcount;
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = comm;
+      }
+
+      if(!datatype->isModifiedBufferRequired()) {
+        datatype->clearIndices(recvbuf, 0, recvcount);
+      }
+
+      rStatus = MPI_Reduce_scatter_wrap(sendbufMod, recvbufMod, recvcounts, displsMod, recvcount,
+                                        datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, comm);
+      adType->addToolAction(h);
+
+      if(datatype->isModifiedBufferRequired()) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcount);
+      }
+
+      adType->stopAssembly(h);
+      if(datatype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
+
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(datatype->isModifiedBufferRequired() ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatter_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Scatter_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Scatter_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Iscatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                            h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root,
+                                            h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
+    AMPI_Scatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Scatter_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                   typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
+                            comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = sendcount * getCommSize(comm);
+
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcount;
+      }
+
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(sendtype->isModifiedBufferRequired()) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(sendcount);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
+                                  0, sendcount);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Scatter_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Scatter_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Scatter_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = comm;
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), sendcount);
+        }
+      }
+
+      rStatus = MPI_Scatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                            recvtype->getModifiedMpiType(), root, comm);
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm),
+                                           sendbufMod, sendcount * getCommRank(comm), sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
+                                  h->recvbufOldPrimals, 0, sendcount);
+        }
+      }
+
+      adType->stopAssembly(h);
+
+      if(root == getCommRank(comm)) {
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatterv_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Scatterv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
+    }
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Scatterv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Iscatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                             h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec,
+                                             h->recvcount, h->recvtype, h->root, h->comm, &deferred->request);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+#endif
+    AMPI_Scatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(), h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Scatterv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+      delete [] h->sendbufCountVec;
+      delete [] h->sendbufDisplsVec;
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs,
+                    SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                             root, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = displsTotalSize;
+
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcounts[getCommRank(comm)];
+      }
+
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(sendtype->isModifiedBufferRequired()) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
+                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            {
+              const int rank = getCommRank(comm);
+              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+            }
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+          }
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices, 0,
+                                    sendcounts[rank]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Scatterv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Scatterv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Scatterv_p<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->displs = displs;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = comm;
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      rStatus = MPI_Scatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                             recvtype->getModifiedMpiType(), root, comm);
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendbufMod,
+                                             displsMod[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices,
+                                    h->recvbufOldPrimals, 0, sendcounts[rank]);
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
+
+      if(root == getCommRank(comm)) {
+        if(sendtype->isModifiedBufferRequired() ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgather_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Ineighbor_allgather_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgather_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommConnectedOutDegree(h->comm));
+
+    AMPI_Ineighbor_allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommConnectedOutDegree(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                               typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_allgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                        recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = 0 != getCommConnectedOutDegree(comm) ? sendtype->computeActiveElements(sendbufElements) : 0;
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvcount * getCommConnectedInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, i * recvcount, h->recvbufOldPrimals, indexPos, recvcount);
+                indexPos += recvcount;
+              }
+            }
+          }
+        }
+
+
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        }
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, i * recvcount, h->recvbufIndices, indexPos, recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_allgather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_allgather_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_allgather_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      rStatus = MPI_Ineighbor_allgather(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                        recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_allgather_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ineighbor_allgather_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Ineighbor_allgather_d<SENDTYPE, RECVTYPE>, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(adType->isActiveType()) {
+
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, i * recvcount, recvbufMod, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, i * recvcount, h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgatherv_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Ineighbor_allgatherv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgatherv_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* displsMod;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                      h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+                                                      &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                      h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm,
+                                                      &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommConnectedOutDegree(h->comm));
+
+    AMPI_Ineighbor_allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                      h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm,
+                                                      &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommConnectedOutDegree(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                                typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs, RECVTYPE* recvtype, AMPI_Comm comm,
+                                AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_allgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                         recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = displsTotalSize;
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = 0 != getCommConnectedOutDegree(comm) ? sendtype->computeActiveElements(sendbufElements) : 0;
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommInDegree(comm), recvtype);
+        clearProcNullNeighborCounts(h->recvbufCount, comm, getCommInDegree(comm));
+        h->recvbufTotalSize = computeDisplacementsTotalSize(h->recvbufCount, getCommInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, indexPos, recvcounts[i]);
+                indexPos += recvcounts[i];
+              }
+            }
+          }
+        }
+
+
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        }
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, indexPos, recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_allgatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_allgatherv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_allgatherv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
+        h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
+          }
+        }
+      }
+
+      rStatus = MPI_Ineighbor_allgatherv(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod,
+                                         recvcounts, displsMod,
+                                         recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_allgatherv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ineighbor_allgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Ineighbor_allgatherv_d<SENDTYPE, RECVTYPE>, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(adType->isActiveType()) {
+
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoall_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Ineighbor_alltoall_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoall_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Ineighbor_alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                              typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_alltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                       recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount * getCommOutDegree(comm);
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, i * sendcount, sendbufMod, i * sendcount, sendcount);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendcount * getCommConnectedOutDegree(comm));
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvcount * getCommConnectedInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, i * recvcount, h->recvbufOldPrimals, indexPos, recvcount);
+                indexPos += recvcount;
+              }
+            }
+          }
+        }
+
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommOutDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              sendtype->getIndices(sendbuf, i * sendcount, h->sendbufIndices, indexPos, sendcount);
+              indexPos += sendcount;
+            }
+          }
+        }
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, i * recvcount, h->recvbufIndices, indexPos, recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_alltoall_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_alltoall_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_alltoall_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      rStatus = MPI_Ineighbor_alltoall(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                       recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_alltoall_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ineighbor_alltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Ineighbor_alltoall_d<SENDTYPE, RECVTYPE>, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(adType->isActiveType()) {
+
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, i * recvcount, recvbufMod, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, i * recvcount, h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoallv_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* sdispls;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* rdispls;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Ineighbor_alltoallv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoallv_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* sdisplsMod;
+    const  int* sendcounts;
+    const  int* sdispls;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* rdisplsMod;
+    const  int* recvcounts;
+    const  int* rdispls;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec,
+                                                     h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                                     h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Ineighbor_alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                                     h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse, h->reverseComm);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+    waitReverse(&h->requestReverse);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts,
+                               const int* sdispls,
+                               SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* rdispls, RECVTYPE* recvtype,
+                               AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_alltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts,
+                                        rdispls, recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* sdisplsMod = sdispls;
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommOutDegree(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          sdisplsMod = createLinearDisplacements(sendcounts, getCommOutDegree(comm));
+        }
+      }
+      MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          rdisplsMod = createLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sdisplsTotalSize;
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = rdisplsTotalSize;
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        createLinearIndexCounts(h->sendbufCount, sendcounts, sdispls, getCommOutDegree(comm), sendtype);
+        clearProcNullNeighborCounts(h->sendbufCount, comm, getCommOutDegree(comm));
+        h->sendbufTotalSize = computeDisplacementsTotalSize(h->sendbufCount, getCommOutDegree(comm));
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, rdispls, getCommInDegree(comm), recvtype);
+        clearProcNullNeighborCounts(h->recvbufCount, comm, getCommInDegree(comm));
+        h->recvbufTotalSize = computeDisplacementsTotalSize(h->recvbufCount, getCommInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, indexPos, recvcounts[i]);
+                indexPos += recvcounts[i];
+              }
+            }
+          }
+        }
+
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommOutDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              sendtype->getIndices(sendbuf, sdispls[i], h->sendbufIndices, indexPos, sendcounts[i]);
+              indexPos += sendcounts[i];
+            }
+          }
+        }
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, rdispls[i], h->recvbufIndices, indexPos, recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_alltoallv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_alltoallv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_alltoallv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->sdispls = sdispls;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->rdispls = rdispls;
+        h->recvtype = recvtype;
+        h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
+          }
+        }
+      }
+
+      rStatus = MPI_Ineighbor_alltoallv(sendbufMod, sendcounts, sdisplsMod, sendtype->getModifiedMpiType(),
+                                        recvbufMod, recvcounts,
+                                        rdisplsMod, recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sdisplsMod = sdisplsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->sdispls = sdispls;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->rdisplsMod = rdisplsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->rdispls = rdispls;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_alltoallv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ineighbor_alltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                           (ForwardFunction)AMPI_Ineighbor_alltoallv_d<SENDTYPE, RECVTYPE>, h);
+        adType->addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* sdisplsMod = asyncHandle->sdisplsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* sdispls = asyncHandle->sdispls;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* rdisplsMod = asyncHandle->rdisplsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* rdispls = asyncHandle->rdispls;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (asyncHandle->toolHandle);
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(adType->isActiveType()) {
+
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] sdisplsMod;
+      }
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] rdisplsMod;
+      }
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Neighbor_allgather_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    LargeCount recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Neighbor_allgather_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommConnectedOutDegree(h->comm));
+
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Neighbor_allgather_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ineighbor_allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount,
+                                                       h->sendtype, h->recvbufAdjoints, h->recvbufCountVec,
+                                                       h->recvcount, h->recvtype, h->comm, &deferred->request, h->reverseComm);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+    AMPI_Neighbor_allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
+    AMPI_Neighbor_allgather_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommConnectedOutDegree(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Neighbor_allgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                              typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Neighbor_allgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                       recvtype->getMpiType(), comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = 0 != getCommConnectedOutDegree(comm) ? sendtype->computeActiveElements(sendbufElements) : 0;
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvcount * getCommConnectedInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(adType->isOldPrimalsRequired()) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, i * recvcount, h->recvbufOldPrimals, indexPos, recvcount);
+                indexPos += recvcount;
+              }
+            }
+          }
+        }
+
+
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        }
+
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, i * recvcount, h->recvbufIndices, indexPos, recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Neighbor_allgather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_allgather_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_allgather_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
+      }
+
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      rStatus = MPI_Neighbor_allgather(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                       recvtype->getModifiedMpiType(), comm);
+      adType->addToolAction(h);
+
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, i * recvcount, recvbufMod, i * recvcount, recvcount);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, i * recvcount, h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcount);
+              indexPos += recvcount;
+            }
+          }
+        }
+      }
+
+      adType->stopAssembly(h);
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Neighbor_allgatherv_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    LargeCount sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    MEDI_OPTIONAL_CONST  int* recvcounts;
+    MEDI_OPTIONAL_CONST  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Comm reverseComm;
+
+    ~AMPI_Neighbor_allgatherv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm, h->reverseComm);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm, h->reverseComm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    h->recvbufAdjoints = nullptr;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(adType->isOldPrimalsRequired()) {
+      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommConnectedOutDegree(h->comm));
+
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Neighbor_allgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ineighbor_allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount,
+                                                        h->sendtype, h->recvbufAdjoints, h->recvbufCountVec,
+                                                        h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype,
+                                                        h->comm, &deferred->request, h->reverseComm);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
+    }
+    AMPI_Neighbor_allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->displs, h->recvtype, h->comm, h->reverseComm);
+    AMPI_Neighbor_allgatherv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommConnectedOutDegree(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Neighbor_allgatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                               typename RECVTYPE::Type* recvbuf, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs,
+                               RECVTYPE* recvtype, AMPI_Comm comm) {
+    int rStatus;
+    ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
+
+    if(!adType->isActiveType()) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Neighbor_allgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                        recvtype->getMpiType(), comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          displsMod = createLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = displsTotalSize;
+
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(adType->isHandleRequired()) {
+        h = new AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      adType->startAssembly(h);
+      if(sendtype->isModifiedBufferRequired()) {
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         }
       }
 
@@ -11271,103 +15340,102 @@ namespace medi {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(AMPI_IN_PLACE != sendbuf) {
-          h->sendbufCount = datatype->computeActiveElements(count);
-        } else {
-          h->sendbufCount = datatype->computeActiveElements(count);
-        }
-        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
-        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        if(root == getCommRank(comm)) {
-          h->recvbufCount = datatype->computeActiveElements(count);
-          h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
-          datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
-        }
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = 0 != getCommConnectedOutDegree(comm) ? sendtype->computeActiveElements(sendbufElements) : 0;
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommInDegree(comm), recvtype);
+        clearProcNullNeighborCounts(h->recvbufCount, comm, getCommInDegree(comm));
+        h->recvbufTotalSize = computeDisplacementsTotalSize(h->recvbufCount, getCommInDegree(comm));
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
-        // extract the primal values for the operator if required
-        if(convOp.requiresPrimal) {
-          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
-          if(AMPI_IN_PLACE != sendbuf) {
-            datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
-          } else {
-            datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
-          }
-        }
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
         if(adType->isOldPrimalsRequired()) {
-          if(root == getCommRank(comm)) {
-            datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-            if(root == getCommRank(comm)) {
-              datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, indexPos, recvcounts[i]);
+                indexPos += recvcounts[i];
+              }
             }
           }
         }
 
 
-        if(AMPI_IN_PLACE != sendbuf) {
-          datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
-        } else {
-          datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
+        if(0 != getCommConnectedOutDegree(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
         }
 
-        if(root == getCommRank(comm)) {
-          datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, indexPos, recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
+          }
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Reduce_global_b<DATATYPE>;
-        h->funcForward = AMPI_Reduce_global_d<DATATYPE>;
-        h->funcPrimal = AMPI_Reduce_global_p<DATATYPE>;
-        h->count = count;
-        h->datatype = datatype;
-        h->op = op;
-        h->root = root;
+        h->funcReverse = AMPI_Neighbor_allgatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_allgatherv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_allgatherv_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
         h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
       }
 
-      if(root == getCommRank(comm)) {
-        if(!datatype->isModifiedBufferRequired()) {
-          datatype->clearIndices(recvbuf, 0, count);
+      if(!recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
+          }
         }
       }
 
-      rStatus = MPI_Reduce(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, root,
-                           comm);
+      rStatus = MPI_Neighbor_allgatherv(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcounts,
+                                        displsMod, recvtype->getModifiedMpiType(), comm);
       adType->addToolAction(h);
 
-      if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()) {
-          datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+      if(recvtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
+          }
         }
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(root == getCommRank(comm)) {
-          datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
-        }
-      }
-      // extract the primal values for the operator if required
-      if(nullptr != h && convOp.requiresPrimal) {
-        if(root == getCommRank(comm)) {
-          datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
-          if(root == getCommRank(comm)) {
-            datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
           }
         }
       }
 
       adType->stopAssembly(h);
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] displsMod;
+      }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
-        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired() ) {
-          datatype->deleteModifiedTypeBuffer(recvbufMod);
-        }
+      if(recvtype->isModifiedBufferRequired() ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
       // handle is deleted by the AD tool
@@ -11377,15 +15445,15 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Scatter_AdjointHandle : public HandleBase {
+  struct AMPI_Neighbor_alltoall_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
-    int sendbufCountVec;
+    LargeCount sendbufCountVec;
     int sendcount;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
@@ -11394,13 +15462,13 @@ namespace medi {
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
-    int recvbufCountVec;
+    LargeCount recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
-    int root;
     AMPI_Comm comm;
+    AMPI_Comm reverseComm;
 
-    ~AMPI_Scatter_AdjointHandle () {
+    ~AMPI_Neighbor_alltoall_AdjointHandle () {
       if(nullptr != sendbufIndices) {
         sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
@@ -11426,30 +15494,26 @@ namespace medi {
 
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    }
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
@@ -11459,44 +15523,43 @@ namespace medi {
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    h->recvbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -11505,60 +15568,71 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    h->sendbufCountVec = (LargeCount)adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Neighbor_alltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ineighbor_alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                      h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype,
+                                                      h->comm, &deferred->request, h->reverseComm);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
     }
+    AMPI_Neighbor_alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, h->reverseComm);
+    AMPI_Neighbor_alltoall_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
 
-    AMPI_Scatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Scatter(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
-                   typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  int AMPI_Neighbor_alltoall(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                             typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
     ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
 
     if(!adType->isActiveType()) {
       // call the regular function if the type is not active
-      rStatus = MPI_Scatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
-                            comm);
+      rStatus = MPI_Neighbor_alltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                      recvtype->getMpiType(), comm);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = sendcount * getCommSize(comm);
+      // compute the total size of the buffer
+      sendbufElements = sendcount * getCommOutDegree(comm);
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
       }
       typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcount;
-      }
+      recvbufElements = recvcount * getCommInDegree(comm);
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(recvtype->isModifiedBufferRequired() ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -11566,12 +15640,14 @@ namespace medi {
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
       if(adType->isHandleRequired()) {
-        h = new AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+        h = new AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       adType->startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+      if(sendtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, i * sendcount, sendbufMod, i * sendcount, sendcount);
+          }
         }
       }
 
@@ -11579,17 +15655,11 @@ namespace medi {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          h->sendbufCount = sendtype->computeActiveElements(sendcount);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(sendcount);
-        }
-        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendcount * getCommConnectedOutDegree(comm));
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvcount * getCommConnectedInDegree(comm));
         recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
 
@@ -11597,76 +15667,90 @@ namespace medi {
         // needs the primal values reset
         if(adType->isOldPrimalsRequired()) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, i * recvcount, h->recvbufOldPrimals, indexPos, recvcount);
+                indexPos += recvcount;
+              }
+            }
           }
         }
 
 
-        if(root == getCommRank(comm)) {
-          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommOutDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              sendtype->getIndices(sendbuf, i * sendcount, h->sendbufIndices, indexPos, sendcount);
+              indexPos += sendcount;
+            }
+          }
         }
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
-                                  0, sendcount);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, i * recvcount, h->recvbufIndices, indexPos, recvcount);
+              indexPos += recvcount;
+            }
+          }
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Scatter_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Scatter_d<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Scatter_p<SENDTYPE, RECVTYPE>;
+        h->funcReverse = AMPI_Neighbor_alltoall_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_alltoall_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_alltoall_p<SENDTYPE, RECVTYPE>;
         h->sendcount = sendcount;
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->root = root;
         h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
       }
 
       if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), sendcount);
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, i * recvcount, recvcount);
+          }
         }
       }
 
-      rStatus = MPI_Scatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                            recvtype->getModifiedMpiType(), root, comm);
+      rStatus = MPI_Neighbor_alltoall(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                      recvtype->getModifiedMpiType(), comm);
       adType->addToolAction(h);
 
       if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm),
-                                           sendbufMod, sendcount * getCommRank(comm), sendcount);
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, i * recvcount, recvbufMod, i * recvcount, recvcount);
+          }
         }
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), sendcount * getCommRank(comm), h->recvbufIndices,
-                                  h->recvbufOldPrimals, 0, sendcount);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, i * recvcount, h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcount);
+              indexPos += recvcount;
+            }
+          }
         }
       }
 
       adType->stopAssembly(h);
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(recvtype->isModifiedBufferRequired() ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -11677,32 +15761,34 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Scatterv_AdjointHandle : public HandleBase {
+  struct AMPI_Neighbor_alltoallv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int* sendbufCount;
     /* required for async */ int* sendbufCountVec;
-    /* required for async */ int* sendbufDisplsVec;
-    const  int* sendcounts;
-    const  int* displs;
+    /* required for async */ int* sendbufDisplsVec;
+    MEDI_OPTIONAL_CONST  int* sendcounts;
+    MEDI_OPTIONAL_CONST  int* sdispls;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
-    int recvbufCount;
-    int recvbufCountVec;
-    int recvcount;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    MEDI_OPTIONAL_CONST  int* recvcounts;
+    MEDI_OPTIONAL_CONST  int* rdispls;
     RECVTYPE* recvtype;
-    int root;
     AMPI_Comm comm;
+    AMPI_Comm reverseComm;
 
-    ~AMPI_Scatterv_AdjointHandle () {
+    ~AMPI_Neighbor_alltoallv_AdjointHandle () {
       if(nullptr != sendbufIndices) {
         sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
@@ -11727,88 +15813,93 @@ namespace medi {
         recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
     }
   };
 
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec,
+                                                    h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm, h->reverseComm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     if(adType->isOldPrimalsRequired()) {
       adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                                    h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm, h->reverseComm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface);
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
       (handle);
     ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
     (void)adType;
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm));
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
     adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
@@ -11817,71 +15908,95 @@ namespace medi {
       adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    if(deferredReverseCollectives()) {
+      DeferredReverseCollective* deferred = new DeferredReverseCollective(handle,
+                                                                          AMPI_Neighbor_alltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                                                          h->sendbufIndices, h->sendbufTotalSize,
+                                                                          adjointInterface);
+      AMPI_Ineighbor_alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                                       h->sendcounts, h->sdispls, h->sendtype, h->recvbufAdjoints,
+                                                       h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts,
+                                                       h->rdispls, h->recvtype, h->comm, &deferred->request, h->reverseComm);
+      adjointInterface->deferAdjointUpdate(deferred);
+
+      return;
     }
+    AMPI_Neighbor_alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, adjointInterface->getVectorSize(),
+                                                    h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, adjointInterface->getVectorSize(), h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm, h->reverseComm);
+    AMPI_Neighbor_alltoallv_b_finish<SENDTYPE, RECVTYPE>(handle, adjointInterface);
+  }
 
-    AMPI_Scatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+      (handle);
+    ADToolInterface const* adType = selectADTool(h->sendtype->getADTool(), h->recvtype->getADTool());
+    (void)adType;
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    delete [] h->sendbufCountVec;
+    delete [] h->sendbufDisplsVec;
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    delete [] h->recvbufCountVec;
+    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Scatterv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs,
-                    SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  int AMPI_Neighbor_alltoallv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, MEDI_OPTIONAL_CONST int* sendcounts,
+                              MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
+                              MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
     ADToolInterface const* adType = selectADTool(sendtype->getADTool(), recvtype->getADTool());
 
     if(!adType->isActiveType()) {
       // call the regular function if the type is not active
-      rStatus = MPI_Scatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
-                             root, comm);
+      rStatus = MPI_Neighbor_alltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts,
+                                       rdispls, recvtype->getMpiType(), comm);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      MEDI_OPTIONAL_CONST int* displsMod = displs;
-      int displsTotalSize = 0;
-      if(nullptr != displs) {
-        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+      AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* sdisplsMod = sdispls;
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommOutDegree(comm));
         if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+          sdisplsMod = createLinearDisplacements(sendcounts, getCommOutDegree(comm));
+        }
+      }
+      MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(recvtype->isModifiedBufferRequired()) {
+          rdisplsMod = createLinearDisplacements(recvcounts, getCommInDegree(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = displsTotalSize;
+      // compute the total size of the buffer
+      sendbufElements = sdisplsTotalSize;
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
       }
       typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcounts[getCommRank(comm)];
-      }
+      recvbufElements = rdisplsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(recvtype->isModifiedBufferRequired() ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -11889,13 +16004,13 @@ namespace medi {
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
       if(adType->isHandleRequired()) {
-        h = new AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+        h = new AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       adType->startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+      if(sendtype->isModifiedBufferRequired()) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
           }
         }
       }
@@ -11904,18 +16019,13 @@ namespace medi {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
-                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
-        }
-        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        createLinearIndexCounts(h->sendbufCount, sendcounts, sdispls, getCommOutDegree(comm), sendtype);
+        clearProcNullNeighborCounts(h->sendbufCount, comm, getCommOutDegree(comm));
+        h->sendbufTotalSize = computeDisplacementsTotalSize(h->sendbufCount, getCommOutDegree(comm));
+        sendtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, rdispls, getCommInDegree(comm), recvtype);
+        clearProcNullNeighborCounts(h->recvbufCount, comm, getCommInDegree(comm));
+        h->recvbufTotalSize = computeDisplacementsTotalSize(h->recvbufCount, getCommInDegree(comm));
         recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
 
@@ -11923,97 +16033,98 @@ namespace medi {
         // needs the primal values reset
         if(adType->isOldPrimalsRequired()) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            {
-              const int rank = getCommRank(comm);
-              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+          {
+            int indexPos = 0;
+            for(int i = 0; i < getCommInDegree(comm); ++i) {
+              if(!isProcNullNeighbor(comm, i)) {
+                recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, indexPos, recvcounts[i]);
+                indexPos += recvcounts[i];
+              }
             }
           }
         }
 
 
-        if(root == getCommRank(comm)) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommOutDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              sendtype->getIndices(sendbuf, sdispls[i], h->sendbufIndices, indexPos, sendcounts[i]);
+              indexPos += sendcounts[i];
+            }
           }
         }
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->createIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices, 0,
-                                    sendcounts[rank]);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->createIndices(recvbuf, rdispls[i], h->recvbufIndices, indexPos, recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
           }
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Scatterv_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Scatterv_d<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Scatterv_p<SENDTYPE, RECVTYPE>;
+        h->funcReverse = AMPI_Neighbor_alltoallv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_alltoallv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_alltoallv_p<SENDTYPE, RECVTYPE>;
         h->sendcounts = sendcounts;
-        h->displs = displs;
+        h->sdispls = sdispls;
         h->sendtype = sendtype;
-        h->recvcount = recvcount;
+        h->recvcounts = recvcounts;
+        h->rdispls = rdispls;
         h->recvtype = recvtype;
-        h->root = root;
         h->comm = comm;
+        h->reverseComm = getTransposedNeighborComm(getShadowComm(comm));
       }
 
       if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->clearIndices(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendcounts[rank]);
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
           }
         }
       }
 
-      rStatus = MPI_Scatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                             recvtype->getModifiedMpiType(), root, comm);
+      rStatus = MPI_Neighbor_alltoallv(sendbufMod, sendcounts, sdisplsMod, sendtype->getModifiedMpiType(), recvbufMod,
+                                       recvcounts, rdisplsMod, recvtype->getModifiedMpiType(), comm);
       adType->addToolAction(h);
 
       if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->copyFromModifiedBuffer(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], sendbufMod,
-                                             displsMod[rank], sendcounts[rank]);
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          if(!isProcNullNeighbor(comm, i)) {
+            recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
           }
         }
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->registerValue(const_cast<typename SENDTYPE::Type*>(sendbuf), displs[rank], h->recvbufIndices,
-                                    h->recvbufOldPrimals, 0, sendcounts[rank]);
+        {
+          int indexPos = 0;
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            if(!isProcNullNeighbor(comm, i)) {
+              recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, indexPos,
+                                      recvcounts[i]);
+              indexPos += recvcounts[i];
+            }
           }
         }
       }
 
       adType->stopAssembly(h);
       if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+        delete [] sdisplsMod;
+      }
+      if(recvtype->isModifiedBufferRequired()) {
+        delete [] rdisplsMod;
       }
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(sendtype->isModifiedBufferRequired() ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(recvtype->isModifiedBufferRequired() ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -12184,18 +16295,6 @@ namespace medi {
     return MPI_Comm_compare(comm1, comm2, result);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_create(AMPI_Comm comm, AMPI_Group group, AMPI_Comm* newcomm) {
-    return MPI_Comm_create(comm, group, newcomm);
-  }
-
-#endif
-#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_create_group(AMPI_Comm comm, AMPI_Group group, int tag, AMPI_Comm* newcomm) {
-    return MPI_Comm_create_group(comm, group, tag, newcomm);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_2_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_create_keyval(AMPI_Comm_copy_attr_function* comm_copy_attr_fn,
@@ -12209,18 +16308,6 @@ namespace medi {
     return MPI_Comm_delete_attr(comm, comm_keyval);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_dup(AMPI_Comm comm, AMPI_Comm* newcomm) {
-    return MPI_Comm_dup(comm, newcomm);
-  }
-
-#endif
-#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_dup_with_info(AMPI_Comm comm, AMPI_Info info, AMPI_Comm* newcomm) {
-    return MPI_Comm_dup_with_info(comm, info, newcomm);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_free(AMPI_Comm* comm) {
@@ -12305,18 +16392,6 @@ namespace medi {
     return MPI_Comm_size(comm, size);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_split(AMPI_Comm comm, int color, int key, AMPI_Comm* newcomm) {
-    return MPI_Comm_split(comm, color, key, newcomm);
-  }
-
-#endif
-#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Comm_split_type(AMPI_Comm comm, int split_type, int key, AMPI_Info info, AMPI_Comm* newcomm) {
-    return MPI_Comm_split_type(comm, split_type, key, info, newcomm);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_test_inter(AMPI_Comm comm, int* flag) {
@@ -12506,13 +16581,6 @@ namespace medi {
     return MPI_Cart_coords(comm, rank, maxdims, coords);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Cart_create(AMPI_Comm comm_old, int ndims, MEDI_OPTIONAL_CONST int* dims,
-                              MEDI_OPTIONAL_CONST int* periods, int reorder, AMPI_Comm* comm_cart) {
-    return MPI_Cart_create(comm_old, ndims, dims, periods, reorder, comm_cart);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Cart_get(AMPI_Comm comm, int maxdims, int* dims, int* periods, int* coords) {
@@ -12538,12 +16606,6 @@ namespace medi {
     return MPI_Cart_shift(comm, direction, disp, rank_source, rank_dest);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Cart_sub(AMPI_Comm comm, MEDI_OPTIONAL_CONST int* remain_dims, AMPI_Comm* newcomm) {
-    return MPI_Cart_sub(comm, remain_dims, newcomm);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Cartdim_get(AMPI_Comm comm, int* ndims) {
@@ -12556,23 +16618,6 @@ namespace medi {
     return MPI_Dims_create(nnodes, ndims, dims);
   }
 
-#endif
-#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
-  inline int AMPI_Dist_graph_create(AMPI_Comm comm_old, int n, MEDI_OPTIONAL_CONST int* sources,
-                                    MEDI_OPTIONAL_CONST int* degrees, MEDI_OPTIONAL_CONST int* destinations, MEDI_OPTIONAL_CONST int* weights,
-                                    AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
-    return MPI_Dist_graph_create(comm_old, n, sources, degrees, destinations, weights, info, reorder, comm_dist_graph);
-  }
-
-#endif
-#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
-  inline int AMPI_Dist_graph_create_adjacent(AMPI_Comm comm_old, int indegree, MEDI_OPTIONAL_CONST int* sources,
-      MEDI_OPTIONAL_CONST int* sourceweights, int outdegree, MEDI_OPTIONAL_CONST int* destinations,
-      MEDI_OPTIONAL_CONST int* destweights, AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
-    return MPI_Dist_graph_create_adjacent(comm_old, indegree, sources, sourceweights, outdegree, destinations, destweights,
-                                          info, reorder, comm_dist_graph);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
   inline int AMPI_Dist_graph_neighbors(AMPI_Comm comm, int maxindegree, int* sources, int* sourceweights,
@@ -12586,13 +16631,6 @@ namespace medi {
     return MPI_Dist_graph_neighbors_count(comm, indegree, outdegree, weighted);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Graph_create(AMPI_Comm comm_old, int nnodes, MEDI_OPTIONAL_CONST int* index,
-                               MEDI_OPTIONAL_CONST int* edges, int reorder, AMPI_Comm* comm_graph) {
-    return MPI_Graph_create(comm_old, nnodes, index, edges, reorder, comm_graph);
-  }
-
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Graph_get(AMPI_Comm comm, int maxindex, int maxedges, int* index, int* edges) {
@@ -39,6 +39,8 @@
 #define MEDI_MPI_VERSION_2_2 202
 #define MEDI_MPI_VERSION_3_0 300
 #define MEDI_MPI_VERSION_3_1 301
+#define MEDI_MPI_VERSION_4_0 400
+#define MEDI_MPI_VERSION_4_1 401
 
 
 #ifndef MEDI_MPI_TARGET
@@ -101,6 +103,17 @@
   #endif
 #endif
 
+/**
+ * @brief Enables the background progress thread, see medi::setProgressThread.
+ *
+ * The application then needs to be compiled and linked with the thread library, e.g. with -pthread.
+ *
+ * It can be set with the preprocessor macro MEDI_EnableProgressThread=<true/false>
+ */
+#ifndef MEDI_EnableProgressThread
+  #define MEDI_EnableProgressThread false
+#endif
+
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
  */
@@ -31,6 +31,9 @@
 
 #include <mpi.h>
 
+#include <climits>
+
+#include "exceptions.hpp"
 #include "macros.h"
 #include "typeDefinitions.h"
 
@@ -43,6 +46,15 @@ namespace medi {
     typedef int Range[3];
   }
 
+  /**
+   * @brief Type for the sizes of buffers that can exceed the range of int, e.g. in vector mode.
+   */
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  typedef MPI_Count LargeCount;
+#else
+  typedef MPI_Aint LargeCount;
+#endif
+
 
   /**
    * @brief Helper function that gets the own rank number from the communicator.
@@ -67,4 +79,376 @@ namespace medi {
 
     return size;
   }
+
+  /**
+   * @brief Helper function that gets the number of source and destination neighbors from a topology communicator.
+   *
+   * Cartesian and graph topologies are symmetric, the numbers are equal for them.
+   *
+   * @param[in]        comm  The communicator with a topology.
+   * @param[out]  indegree  The number of source neighbors.
+   * @param[out] outdegree  The number of destination neighbors.
+   */
+  inline void getCommDegrees(MPI_Comm comm, int& indegree, int& outdegree) {
+    int topology;
+    MEDI_CHECK_ERROR(MPI_Topo_test(comm, &topology));
+
+    if(MPI_CART == topology) {
+      int dims;
+      MEDI_CHECK_ERROR(MPI_Cartdim_get(comm, &dims));
+      indegree = 2 * dims;
+      outdegree = 2 * dims;
+    } else if(MPI_GRAPH == topology) {
+      int neighbors;
+      MEDI_CHECK_ERROR(MPI_Graph_neighbors_count(comm, getCommRank(comm), &neighbors));
+      indegree = neighbors;
+      outdegree = neighbors;
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+    } else if(MPI_DIST_GRAPH == topology) {
+      int weighted;
+      MEDI_CHECK_ERROR(MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted));
+#endif
+    } else {
+      MEDI_EXCEPTION("Communicator has no topology.");
+    }
+  }
+
+  /**
+   * @brief Helper function that gets the number of source neighbors from a topology communicator.
+   * @param[in] comm  The communicator with a topology.
+   * @return The number of ranks this process receives from in a neighborhood collective.
+   */
+  inline int getCommInDegree(MPI_Comm comm) {
+    int indegree;
+    int outdegree;
+    getCommDegrees(comm, indegree, outdegree);
+
+    return indegree;
+  }
+
+  /**
+   * @brief Helper function that gets the number of destination neighbors from a topology communicator.
+   * @param[in] comm  The communicator with a topology.
+   * @return The number of ranks this process sends to in a neighborhood collective.
+   */
+  inline int getCommOutDegree(MPI_Comm comm) {
+    int indegree;
+    int outdegree;
+    getCommDegrees(comm, indegree, outdegree);
+
+    return outdegree;
+  }
+
+  /**
+   * @brief Helper function that checks if a neighbor of a topology communicator is MPI_PROC_NULL.
+   *
+   * Only Cartesian topologies have such neighbors, at the border of the dimensions that are not periodic. The
+   * neighbors are numbered as in the neighborhood collectives, for each dimension the neighbor in the negative
+   * direction comes first. The source and destination neighbors of a Cartesian topology are the same.
+   *
+   * MPI does not send to or receive from these neighbors, their blocks in the buffers are not accessed.
+   *
+   * @param[in]     comm  The communicator with a topology.
+   * @param[in] neighbor  The number of the neighbor in the buffers of a neighborhood collective.
+   * @return True if the neighbor is MPI_PROC_NULL.
+   */
+  inline bool isProcNullNeighbor(MPI_Comm comm, int neighbor) {
+    int topology;
+    MEDI_CHECK_ERROR(MPI_Topo_test(comm, &topology));
+    if(MPI_CART != topology) {
+      return false;
+    }
+
+    int source;
+    int destination;
+    MEDI_CHECK_ERROR(MPI_Cart_shift(comm, neighbor / 2, 1, &source, &destination));
+
+    return MPI_PROC_NULL == (0 == neighbor % 2 ? source : destination);
+  }
+
+  /**
+   * @brief Helper function that counts the neighbors of a topology communicator that are MPI_PROC_NULL.
+   * @param[in] comm  The communicator with a topology.
+   * @return The number of source neighbors that are MPI_PROC_NULL, which is also the number of destination neighbors
+   *         that are MPI_PROC_NULL.
+   */
+  inline int getCommProcNullNeighbors(MPI_Comm comm) {
+    int topology;
+    MEDI_CHECK_ERROR(MPI_Topo_test(comm, &topology));
+    if(MPI_CART != topology) {
+      return 0;
+    }
+
+    int dims;
+    MEDI_CHECK_ERROR(MPI_Cartdim_get(comm, &dims));
+
+    int procNullNeighbors = 0;
+    for(int i = 0; i < 2 * dims; ++i) {
+      if(isProcNullNeighbor(comm, i)) {
+        procNullNeighbors += 1;
+      }
+    }
+
+    return procNullNeighbors;
+  }
+
+  /**
+   * @brief Helper function that gets the number of source neighbors that are not MPI_PROC_NULL.
+   *
+   * MeDiPack stores the AD data of neighborhood collectives only for these neighbors.
+   *
+   * @param[in] comm  The communicator with a topology.
+   * @return The number of ranks this process actually receives from in a neighborhood collective.
+   */
+  inline int getCommConnectedInDegree(MPI_Comm comm) {
+    return getCommInDegree(comm) - getCommProcNullNeighbors(comm);
+  }
+
+  /**
+   * @brief Helper function that gets the number of destination neighbors that are not MPI_PROC_NULL.
+   *
+   * MeDiPack stores the AD data of neighborhood collectives only for these neighbors.
+   *
+   * @param[in] comm  The communicator with a topology.
+   * @return The number of ranks this process actually sends to in a neighborhood collective.
+   */
+  inline int getCommConnectedOutDegree(MPI_Comm comm) {
+    return getCommOutDegree(comm) - getCommProcNullNeighbors(comm);
+  }
+
+  /**
+   * @brief Helper function that creates a keyval for communicator attributes.
+   *
+   * The keyvals of MeDiPack are stored in function local statics that are initialized with this function. The
+   * initialization is thread-safe, concurrent first calls create only one keyval.
+   *
+   * @param[in]   copyFn  The copy function of the attribute.
+   * @param[in] deleteFn  The delete function of the attribute.
+   * @return The new keyval.
+   */
+  inline int createCommKeyval(MPI_Comm_copy_attr_function* copyFn, MPI_Comm_delete_attr_function* deleteFn) {
+    int keyval;
+    MEDI_CHECK_ERROR(MPI_Comm_create_keyval(copyFn, deleteFn, &keyval, nullptr));
+
+    return keyval;
+  }
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  /**
+   * @brief Attribute delete function for the transposed communicator of a distributed graph.
+   */
+  inline int deleteTransposedNeighborComm(MPI_Comm comm, int keyval, void* attributeVal, void* extraState) {
+    MEDI_UNUSED(comm);
+    MEDI_UNUSED(keyval);
+    MEDI_UNUSED(extraState);
+
+    MPI_Comm* transposed = reinterpret_cast<MPI_Comm*>(attributeVal);
+    MPI_Comm_free(transposed);
+    delete transposed;
+
+    return MPI_SUCCESS;
+  }
+#endif
+
+  /**
+   * @brief Get the communicator for the reverse of a neighborhood collective.
+   *
+   * The reverse exchange runs on the same topology with the source and destination neighbors swapped. Cartesian and
+   * graph topologies are symmetric, the communicator itself is returned for them. For distributed graph topologies the
+   * transposed graph is created on the first call and cached as an attribute of the communicator. The call is
+   * therefore collective over the communicator. MeDiPack calls it when a neighborhood collective is recorded, where
+   * all ranks of the communicator take part, and stores the result in the handle for the reverse sweep.
+   *
+   * @param[in] comm  The communicator of the neighborhood collective.
+   * @return The communicator with the transposed topology.
+   */
+  inline MPI_Comm getTransposedNeighborComm(MPI_Comm comm) {
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+    int topology;
+    MPI_Topo_test(comm, &topology);
+    if(MPI_DIST_GRAPH != topology) {
+      return comm;
+    }
+
+    static int keyval = createCommKeyval(MPI_COMM_NULL_COPY_FN, deleteTransposedNeighborComm);
+
+    MPI_Comm* transposed;
+    int flag;
+    MPI_Comm_get_attr(comm, keyval, &transposed, &flag);
+    if(!flag) {
+      int indegree;
+      int outdegree;
+      int weighted;
+      MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+
+      int* sources = new int[indegree + 1];
+      int* sourceWeights = new int[indegree + 1];
+      int* destinations = new int[outdegree + 1];
+      int* destinationWeights = new int[outdegree + 1];
+      MPI_Dist_graph_neighbors(comm, indegree, sources, sourceWeights, outdegree, destinations, destinationWeights);
+
+      transposed = new MPI_Comm;
+      MPI_Dist_graph_create_adjacent(comm, outdegree, destinations, weighted ? destinationWeights : MPI_UNWEIGHTED,
+                                     indegree, sources, weighted ? sourceWeights : MPI_UNWEIGHTED, MPI_INFO_NULL, 0,
+                                     transposed);
+      MPI_Comm_set_attr(comm, keyval, transposed);
+
+      delete [] sources;
+      delete [] sourceWeights;
+      delete [] destinations;
+      delete [] destinationWeights;
+    }
+
+    return *transposed;
+#else
+    return comm;
+#endif
+  }
+
+  /**
+   * @brief Helper function for pointer arithmetic on buffers that are described by an MPI type.
+   *
+   * @param[in]      buf  The start of the buffer.
+   * @param[in] elements  The number of elements that are skipped.
+   * @param[in]     type  The MPI type of the elements in the buffer.
+   * @return The location of the element in the buffer.
+   */
+  inline void* shiftBuffer(void* buf, int elements, MPI_Datatype type) {
+    MPI_Aint lb;
+    MPI_Aint extent;
+    MPI_Type_get_extent(type, &lb, &extent);
+
+    return reinterpret_cast<char*>(buf) + elements * extent;
+  }
+
+  /**
+   * @brief Access to the largest count that is given directly to an MPI call.
+   *
+   * Larger counts are communicated with a derived datatype, see LargeCountType. The value can be lowered for testing
+   * purposes, it needs to be the same on all ranks.
+   *
+   * @return Reference to the limit.
+   */
+  inline LargeCount& largeCountLimit() {
+    static LargeCount limit = INT_MAX;
+
+    return limit;
+  }
+
+  /**
+   * @brief Set the largest count that is given directly to an MPI call.
+   * @param[in] limit  The new limit, values above INT_MAX are not supported.
+   */
+  inline void setLargeCountLimit(LargeCount limit) {
+    mediAssert(0 < limit && limit <= INT_MAX);
+    largeCountLimit() = limit;
+  }
+
+  /**
+   * @brief Check if a count can not be given directly to an MPI call.
+   * @param[in] count  The number of elements.
+   * @return True if a LargeCountType creates a derived datatype for the count.
+   */
+  inline bool isLargeCount(LargeCount count) {
+    return count > largeCountLimit();
+  }
+
+  /**
+   * @brief Count and datatype pair for MPI calls with more elements than an int can hold.
+   *
+   * If the number of elements is above the limit, a derived datatype is created that contains all elements. The
+   * count is then one. The derived datatype consists of contiguous blocks with the limit as size and a remainder, its
+   * type signature is the same as for the elements of the base type. The type is freed in the destructor, which is
+   * also valid for pending non-blocking operations.
+   *
+   * The derived datatype can not be used with the predefined reduction operations.
+   */
+  struct LargeCountType {
+      int count;
+      MPI_Datatype type;
+      bool isDerived;
+
+      /**
+       * @brief Create the count and datatype for the elements.
+       *
+       * @param[in] elements  The number of elements in the buffer.
+       * @param[in] baseType  The type of the elements.
+       */
+      LargeCountType(LargeCount elements, MPI_Datatype baseType) :
+        count(0),
+        type(baseType),
+        isDerived(isLargeCount(elements)) {
+        if(!isDerived) {
+          count = (int)elements;
+        } else {
+          LargeCount limit = largeCountLimit();
+          int blockLengths[2] = {(int)(elements / limit), (int)(elements % limit)};
+
+          MPI_Aint lb;
+          MPI_Aint extent;
+          MPI_Type_get_extent(baseType, &lb, &extent);
+
+          MPI_Datatype blockType;
+          MPI_Type_contiguous((int)limit, baseType, &blockType);
+
+          MPI_Datatype types[2] = {blockType, baseType};
+          MPI_Aint displs[2] = {0, (MPI_Aint)(elements - blockLengths[1]) * extent};
+          MPI_Type_create_struct(2, blockLengths, displs, types, &type);
+          MPI_Type_commit(&type);
+          MPI_Type_free(&blockType);
+
+          count = 1;
+        }
+      }
+
+      ~LargeCountType() {
+        if(isDerived) {
+          MPI_Type_free(&type);
+        }
+      }
+
+    private:
+      LargeCountType(const LargeCountType&) = delete;
+      LargeCountType& operator=(const LargeCountType&) = delete;
+  };
+
+  /**
+   * @brief Datatype for the vectors of adjoint values in the v-collectives.
+   *
+   * The counts and displacements of the v-collectives are given in active elements. In the vector mode each element
+   * has vectorSize adjoint values, these are combined into one contiguous type. The counts and displacements stay in
+   * the range of the user counts and displacements. For a vector size of one the base type is used directly. The type
+   * is freed in the destructor, which is also valid for pending non-blocking operations.
+   *
+   * The derived datatype can not be used with the predefined reduction operations.
+   */
+  struct VectorType {
+      MPI_Datatype type;
+      bool isDerived;
+
+      /**
+       * @brief Create the datatype for the vectors.
+       *
+       * @param[in] vectorSize  The number of values for each active element.
+       * @param[in]   baseType  The type of the values.
+       */
+      VectorType(int vectorSize, MPI_Datatype baseType) :
+        type(baseType),
+        isDerived(1 != vectorSize) {
+        if(isDerived) {
+          MPI_Type_contiguous(vectorSize, baseType, &type);
+          MPI_Type_commit(&type);
+        }
+      }
+
+      ~VectorType() {
+        if(isDerived) {
+          MPI_Type_free(&type);
+        }
+      }
+
+    private:
+      VectorType(const VectorType&) = delete;
+      VectorType& operator=(const VectorType&) = delete;
+  };
 }
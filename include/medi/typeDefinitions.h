@@ -46,9 +46,12 @@ namespace medi {
   typedef void (*ReverseFunction)(HandleBase* h, AdjointInterface* a);
   typedef void (*ForwardFunction)(HandleBase* h, AdjointInterface* a);
   typedef void (*PrimalFunction)(HandleBase* h, AdjointInterface* a);
+  typedef bool (*PrefetchFunction)(HandleBase* h, AdjointInterface* a);
   typedef int (*ContinueFunction)(HandleBase* h);
   typedef void (*PreAdjointOperation)(void* adjoints, void* primals, int count, int dim);
   typedef void (*PostAdjointOperation)(void* adjoints, void* primals, void* rootPrimals, int count, int dim);
+  typedef void (*PackOwnerOperation)(const void* buf, const void* primals, void* ownerBuf, int count, int rank);
+  typedef void (*UnpackOwnerOperation)(const void* ownerBuf, int* owners, int count);
   typedef void (*CustomFunction)(void* data);
 
   struct HandleBase {
@@ -59,6 +62,7 @@ namespace medi {
     ReverseFunction funcReverse;
     ForwardFunction funcForward;
     PrimalFunction funcPrimal;
+    PrefetchFunction funcPrefetch;
     ManualDeleteType deleteType;
 
     HandleBase() :
@@ -68,6 +72,7 @@ namespace medi {
       funcReverse(NULL),
       funcForward(NULL),
       funcPrimal(NULL),
+      funcPrefetch(NULL),
       deleteType(ManualDeleteType::Normal) {}
 
 
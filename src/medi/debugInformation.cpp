@@ -39,7 +39,7 @@
 namespace medi {
 
 #if MEDI_DebugInformation
-std::string debugInformation;
+thread_local std::string debugInformation;
 #endif
 
 void printDebugInformationWarning(std::string const& functionName) {
@@ -88,7 +88,15 @@ void outputGradient(NUMBER* vec, size_t size) {
 
 int main(int nargs, char** args) {
 
+#if PROGRESS_THREAD
+  medi::setProgressThread(true);
+#endif
+#if PROGRESS_THREAD || MULTI_THREADED
+  int provided;
+  medi::AMPI_Init_thread(&nargs, &args, MPI_THREAD_MULTIPLE, &provided);
+#else
   medi::AMPI_Init(&nargs, &args);
+#endif
 
   int world_rank;
   medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
@@ -97,6 +105,11 @@ int main(int nargs, char** args) {
 
   TOOL = new TOOL_TYPE();
 
+#if PARALLEL_ELEMENTS
+  // Run the element loops of all datatype operations with OpenMP.
+  medi::setParallelElementThreshold(1);
+#endif
+
   int evalPoints = getEvalPointsCount();
   int inputs = getInputCount();
   int outputs = getOutputCount();
@@ -172,3 +185,7 @@ int main(int nargs, char** args) {
 TOOL_TYPE* TOOL;
 
 #include <medi/medi.cpp>
+
+#ifdef MPI4_EMULATION
+# include <mpi4Emulation.cpp>
+#endif
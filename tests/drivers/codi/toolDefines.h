@@ -28,6 +28,10 @@
 
 #pragma once
 
+#ifdef MPI4_EMULATION
+# include <mpi4Emulation.h>
+#endif
+
 #include <codi.hpp>
 #include <medi/medi.hpp>
 #if CODI_MAJOR_VERSION >= 2
@@ -54,6 +58,18 @@ typedef CODI_TYPE NUMBER;
 # define PRIMAL_TAPE 0
 #endif
 
+#ifndef PARALLEL_ELEMENTS
+# define PARALLEL_ELEMENTS 0
+#endif
+
+#ifndef PROGRESS_THREAD
+# define PROGRESS_THREAD 0
+#endif
+
+#ifndef MULTI_THREADED
+# define MULTI_THREADED 0
+#endif
+
 #if CODI_MAJOR_VERSION >= 2
   #define TOOL_TYPE codi::CoDiMpiTypes<NUMBER>
 #else
@@ -0,0 +1,329 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#include "mpi4Emulation.h"
+
+#if MPI4_EMULATED
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+namespace mpi4Emulation {
+
+  enum class Kind {
+    Psend,
+    Precv,
+    Allreduce,
+    Bcast,
+    Allgather,
+    Gather
+  };
+
+  struct Request {
+      Kind kind;
+
+      const void* sendbuf;
+      void* recvbuf;
+      int sendcount;
+      MPI_Datatype sendtype;
+      int recvcount;
+      MPI_Datatype recvtype;
+      MPI_Op op;
+      int rank;
+      int tag;
+      MPI_Comm comm;
+
+      int partitions;
+      std::atomic<int> readyCount;
+      bool complete;
+
+      MPI_Request active;
+
+      Request(Kind kind) :
+        kind(kind),
+        sendbuf(nullptr),
+        recvbuf(nullptr),
+        sendcount(0),
+        sendtype(MPI_DATATYPE_NULL),
+        recvcount(0),
+        recvtype(MPI_DATATYPE_NULL),
+        op(MPI_OP_NULL),
+        rank(0),
+        tag(0),
+        comm(MPI_COMM_NULL),
+        partitions(0),
+        readyCount(0),
+        complete(false),
+        active(MPI_REQUEST_NULL) {}
+  };
+
+  inline std::mutex& getMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  inline std::set<Request*>& getRequests() {
+    static std::set<Request*> requests;
+    return requests;
+  }
+
+  inline int create(Request* r, MPI_Request* request) {
+    std::lock_guard<std::mutex> lock(getMutex());
+    getRequests().insert(r);
+    *request = reinterpret_cast<MPI_Request>(r);
+
+    return MPI_SUCCESS;
+  }
+
+  inline Request* find(MPI_Request request) {
+    std::lock_guard<std::mutex> lock(getMutex());
+    Request* r = reinterpret_cast<Request*>(request);
+    if(0 != getRequests().count(r)) {
+      return r;
+    } else {
+      return nullptr;
+    }
+  }
+
+  inline void remove(Request* r) {
+    std::lock_guard<std::mutex> lock(getMutex());
+    getRequests().erase(r);
+    delete r;
+  }
+
+  inline int start(Request* r) {
+    r->readyCount = 0;
+    r->complete = false;
+
+    switch(r->kind) {
+      case Kind::Psend:
+        // Posted when the last partition is ready.
+        return MPI_SUCCESS;
+      case Kind::Precv:
+        return PMPI_Irecv(r->recvbuf, r->partitions * r->recvcount, r->recvtype, r->rank, r->tag, r->comm, &r->active);
+      case Kind::Allreduce:
+        return PMPI_Iallreduce(r->sendbuf, r->recvbuf, r->sendcount, r->sendtype, r->op, r->comm, &r->active);
+      case Kind::Bcast:
+        return PMPI_Ibcast(r->recvbuf, r->recvcount, r->recvtype, r->rank, r->comm, &r->active);
+      case Kind::Allgather:
+        return PMPI_Iallgather(r->sendbuf, r->sendcount, r->sendtype, r->recvbuf, r->recvcount, r->recvtype, r->comm,
+                               &r->active);
+      case Kind::Gather:
+        return PMPI_Igather(r->sendbuf, r->sendcount, r->sendtype, r->recvbuf, r->recvcount, r->recvtype, r->rank,
+                            r->comm, &r->active);
+    }
+
+    return MPI_ERR_REQUEST;
+  }
+
+  inline int ready(Request* r, int count) {
+    int readyCount = r->readyCount.fetch_add(count) + count;
+    if(readyCount == r->partitions) {
+      return PMPI_Isend(r->sendbuf, r->partitions * r->sendcount, r->sendtype, r->rank, r->tag, r->comm, &r->active);
+    }
+
+    return MPI_SUCCESS;
+  }
+
+  inline int partitioned(Kind kind, const void* buf, int partitions, MPI_Count count, MPI_Datatype datatype, int rank,
+                         int tag, MPI_Comm comm, MPI_Request* request) {
+    Request* r = new Request(kind);
+    if(Kind::Psend == kind) {
+      r->sendbuf = buf;
+      r->sendcount = (int)count;
+      r->sendtype = datatype;
+    } else {
+      r->recvbuf = const_cast<void*>(buf);
+      r->recvcount = (int)count;
+      r->recvtype = datatype;
+    }
+    r->partitions = partitions;
+    r->rank = rank;
+    r->tag = tag;
+    r->comm = comm;
+
+    return create(r, request);
+  }
+
+  inline int collective(Kind kind, const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf,
+                        int recvcount, MPI_Datatype recvtype, MPI_Op op, int root, MPI_Comm comm, MPI_Request* request) {
+    Request* r = new Request(kind);
+    r->sendbuf = sendbuf;
+    r->sendcount = sendcount;
+    r->sendtype = sendtype;
+    r->recvbuf = recvbuf;
+    r->recvcount = recvcount;
+    r->recvtype = recvtype;
+    r->op = op;
+    r->rank = root;
+    r->comm = comm;
+
+    return create(r, request);
+  }
+}
+
+extern "C" {
+
+  int MPI_Psend_init(const void* buf, int partitions, MPI_Count count, MPI_Datatype datatype, int dest, int tag,
+                     MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::partitioned(mpi4Emulation::Kind::Psend, buf, partitions, count, datatype, dest, tag, comm,
+                                      request);
+  }
+
+  int MPI_Precv_init(void* buf, int partitions, MPI_Count count, MPI_Datatype datatype, int source, int tag,
+                     MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::partitioned(mpi4Emulation::Kind::Precv, buf, partitions, count, datatype, source, tag, comm,
+                                      request);
+  }
+
+  int MPI_Pready(int partition, MPI_Request request) {
+    (void)partition;
+    return mpi4Emulation::ready(reinterpret_cast<mpi4Emulation::Request*>(request), 1);
+  }
+
+  int MPI_Pready_range(int partition_low, int partition_high, MPI_Request request) {
+    return mpi4Emulation::ready(reinterpret_cast<mpi4Emulation::Request*>(request), partition_high - partition_low + 1);
+  }
+
+  int MPI_Pready_list(int length, const int array_of_partitions[], MPI_Request request) {
+    (void)array_of_partitions;
+    return mpi4Emulation::ready(reinterpret_cast<mpi4Emulation::Request*>(request), length);
+  }
+
+  int MPI_Parrived(MPI_Request request, int partition, int* flag) {
+    (void)partition;
+
+    // All partitions arrive when the receive is complete.
+    return MPI_Test(&request, flag, MPI_STATUS_IGNORE);
+  }
+
+  int MPI_Allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                         MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::collective(mpi4Emulation::Kind::Allreduce, sendbuf, count, datatype, recvbuf, count, datatype,
+                                     op, 0, comm, request);
+  }
+
+  int MPI_Bcast_init(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Info info,
+                     MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::collective(mpi4Emulation::Kind::Bcast, nullptr, 0, MPI_DATATYPE_NULL, buffer, count,
+                                     datatype, MPI_OP_NULL, root, comm, request);
+  }
+
+  int MPI_Allgather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                         MPI_Datatype recvtype, MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::collective(mpi4Emulation::Kind::Allgather, sendbuf, sendcount, sendtype, recvbuf, recvcount,
+                                     recvtype, MPI_OP_NULL, 0, comm, request);
+  }
+
+  int MPI_Gather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                      MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    (void)info;
+    return mpi4Emulation::collective(mpi4Emulation::Kind::Gather, sendbuf, sendcount, sendtype, recvbuf, recvcount,
+                                     recvtype, MPI_OP_NULL, root, comm, request);
+  }
+
+  /*
+   * Interception of the request functions with the profiling interface.
+   */
+
+  int MPI_Start(MPI_Request* request) {
+    mpi4Emulation::Request* r = mpi4Emulation::find(*request);
+    if(nullptr != r) {
+      return mpi4Emulation::start(r);
+    } else {
+      return PMPI_Start(request);
+    }
+  }
+
+  int MPI_Startall(int count, MPI_Request array_of_requests[]) {
+    int rStatus = MPI_SUCCESS;
+    for(int i = 0; i < count && MPI_SUCCESS == rStatus; ++i) {
+      rStatus = MPI_Start(&array_of_requests[i]);
+    }
+
+    return rStatus;
+  }
+
+  int MPI_Wait(MPI_Request* request, MPI_Status* status) {
+    mpi4Emulation::Request* r = mpi4Emulation::find(*request);
+    if(nullptr != r) {
+      r->complete = true;
+      return PMPI_Wait(&r->active, status);
+    } else {
+      return PMPI_Wait(request, status);
+    }
+  }
+
+  int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+    int rStatus = MPI_SUCCESS;
+    for(int i = 0; i < count && MPI_SUCCESS == rStatus; ++i) {
+      MPI_Status* status = MPI_STATUSES_IGNORE == array_of_statuses ? MPI_STATUS_IGNORE : &array_of_statuses[i];
+      rStatus = MPI_Wait(&array_of_requests[i], status);
+    }
+
+    return rStatus;
+  }
+
+  int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status) {
+    mpi4Emulation::Request* r = mpi4Emulation::find(*request);
+    if(nullptr != r) {
+      if(r->complete) {
+        *flag = 1;
+        return MPI_SUCCESS;
+      } else if(MPI_REQUEST_NULL == r->active) {
+        // A partitioned send whose partitions are not all ready.
+        *flag = 0;
+        return MPI_SUCCESS;
+      }
+      int rStatus = PMPI_Test(&r->active, flag, status);
+      r->complete = 0 != *flag;
+      return rStatus;
+    } else {
+      return PMPI_Test(request, flag, status);
+    }
+  }
+
+  int MPI_Request_free(MPI_Request* request) {
+    mpi4Emulation::Request* r = mpi4Emulation::find(*request);
+    if(nullptr != r) {
+      mpi4Emulation::remove(r);
+      *request = MPI_REQUEST_NULL;
+      return MPI_SUCCESS;
+    } else {
+      return PMPI_Request_free(request);
+    }
+  }
+}
+
+#endif
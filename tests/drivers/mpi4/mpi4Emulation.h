@@ -0,0 +1,84 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#pragma once
+
+/*
+ * Emulation of the MPI 4 functions that MeDiPack uses for partitioned communication and persistent collectives. It
+ * allows to test these functions with an MPI 3 library. If the MPI library provides MPI 4, nothing is emulated.
+ *
+ * The header needs to be included before MeDiPack, it sets the target version of MeDiPack to MPI 4.0. The definitions
+ * are in mpi4Emulation.cpp, which is included once in the driver.
+ *
+ * The emulated requests are heap objects whose addresses are used as MPI requests, this requires an MPI library with
+ * pointer request handles, e.g. Open MPI. MPI_Start, MPI_Startall, MPI_Wait, MPI_Test and MPI_Request_free are
+ * intercepted with the MPI profiling interface and forwarded to the emulation for these requests. The other completion
+ * functions are not intercepted and must not be called with emulated requests.
+ *
+ * - A partitioned receive is an MPI_Irecv of the whole buffer that is posted in MPI_Start, all partitions arrive when
+ *   the receive is complete.
+ * - A partitioned send is an MPI_Isend of the whole buffer that is posted when the last partition is marked ready.
+ *   MPI_Pready can be called from several threads, if MPI is initialized with MPI_THREAD_MULTIPLE.
+ * - A persistent collective posts the matching non-blocking collective in MPI_Start.
+ */
+
+#include <mpi.h>
+
+#if MPI_VERSION < 4
+
+#define MPI4_EMULATED 1
+
+#ifndef MEDI_MPI_TARGET
+# define MEDI_MPI_TARGET 400
+#endif
+
+extern "C" {
+  int MPI_Psend_init(const void* buf, int partitions, MPI_Count count, MPI_Datatype datatype, int dest, int tag,
+                     MPI_Comm comm, MPI_Info info, MPI_Request* request);
+  int MPI_Precv_init(void* buf, int partitions, MPI_Count count, MPI_Datatype datatype, int source, int tag,
+                     MPI_Comm comm, MPI_Info info, MPI_Request* request);
+  int MPI_Pready(int partition, MPI_Request request);
+  int MPI_Pready_range(int partition_low, int partition_high, MPI_Request request);
+  int MPI_Pready_list(int length, const int array_of_partitions[], MPI_Request request);
+  int MPI_Parrived(MPI_Request request, int partition, int* flag);
+
+  int MPI_Allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                         MPI_Comm comm, MPI_Info info, MPI_Request* request);
+  int MPI_Bcast_init(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Info info,
+                     MPI_Request* request);
+  int MPI_Allgather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                         MPI_Datatype recvtype, MPI_Comm comm, MPI_Info info, MPI_Request* request);
+  int MPI_Gather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                      MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Info info, MPI_Request* request);
+}
+
+#else
+
+#define MPI4_EMULATED 0
+
+#endif
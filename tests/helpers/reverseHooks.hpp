@@ -0,0 +1,213 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include <medi/medi.hpp>
+
+/*
+ * Emulation of the reverse evaluation hooks that an AD tool can use, independent of the AD tool of the driver.
+ *
+ * The handles of a datatype created with getRecordingType are not added to the tape of the AD tool. The test collects
+ * them and adds a single action with pushReverse. In the reverse evaluation, this action evaluates the collected
+ * handles with the given mode, like an AD tool that supports the hooks would do.
+ */
+
+enum class ReverseMode {
+  Deferred,  // Deferred adjoint updates are queued and completed at the end of the action.
+  Prefetch,  // The adjoint receives of the following handles are posted in advance, see reversePrefetchDepth.
+  Batch      // All handles are evaluated with evaluateReverseBatch.
+};
+
+/**
+ * @brief Adjoint interface that forwards to the interface of the AD tool and queues the deferred updates.
+ */
+struct QueueingAdjointInterface : public medi::AdjointInterface {
+    medi::AdjointInterface* base;
+    mutable std::vector<medi::DeferredAdjointUpdate*> deferred;
+    mutable int deferredCount;
+
+    QueueingAdjointInterface(medi::AdjointInterface* base) :
+      base(base),
+      deferred(),
+      deferredCount(0) {}
+
+    int computeElements(int elements) const { return base->computeElements(elements); }
+    int getVectorSize() const { return base->getVectorSize(); }
+    void createPrimalTypeBuffer(void* &buf, size_t size) const { base->createPrimalTypeBuffer(buf, size); }
+    void deletePrimalTypeBuffer(void* &buf) const { base->deletePrimalTypeBuffer(buf); }
+    void createAdjointTypeBuffer(void* &buf, size_t size) const { base->createAdjointTypeBuffer(buf, size); }
+    void deleteAdjointTypeBuffer(void* &buf) const { base->deleteAdjointTypeBuffer(buf); }
+    void combineAdjoints(void* buf, const int elements, const int ranks) const {
+      base->combineAdjoints(buf, elements, ranks);
+    }
+    void getAdjoints(const void* indices, void* adjoints, int elements) const {
+      base->getAdjoints(indices, adjoints, elements);
+    }
+    void updateAdjoints(const void* indices, const void* adjoints, int elements) const {
+      base->updateAdjoints(indices, adjoints, elements);
+    }
+    void getPrimals(const void* indices, const void* primals, int elements) const {
+      base->getPrimals(indices, primals, elements);
+    }
+    void setPrimals(const void* indices, const void* primals, int elements) const {
+      base->setPrimals(indices, primals, elements);
+    }
+
+    void deferAdjointUpdate(medi::DeferredAdjointUpdate* update) const {
+      deferred.push_back(update);
+      deferredCount += 1;
+    }
+
+    void completeDeferred() {
+      for(medi::DeferredAdjointUpdate* update : deferred) {
+        update->complete();
+        delete update;
+      }
+      deferred.clear();
+    }
+};
+
+/**
+ * @brief A tool action that evaluates the collected handles.
+ *
+ * The handles are stored in the recording order.
+ */
+struct RecordedReverse : public medi::HandleBase {
+    ReverseMode mode;
+    std::vector<medi::HandleBase*> handles;
+
+    RecordedReverse(ReverseMode mode, std::vector<medi::HandleBase*> const& handles) :
+      HandleBase(),
+      mode(mode),
+      handles(handles) {
+      this->funcReverse = RecordedReverse::reverse;
+      this->funcForward = RecordedReverse::forward;
+    }
+
+    ~RecordedReverse() {
+      for(medi::HandleBase* h : handles) {
+        delete h;
+      }
+    }
+
+    static void reverse(medi::HandleBase* handle, medi::AdjointInterface* adjointInterface) {
+      RecordedReverse* r = static_cast<RecordedReverse*>(handle);
+      QueueingAdjointInterface queue(adjointInterface);
+
+      // The handles in the order of the reverse evaluation.
+      std::vector<medi::HandleBase*> handles(r->handles.rbegin(), r->handles.rend());
+      int count = (int)handles.size();
+
+      if(ReverseMode::Batch == r->mode) {
+        medi::evaluateReverseBatch(handles.data(), count, &queue);
+      } else {
+        bool prefetched = false;
+        for(int i = 0; i < count; ++i) {
+          if(ReverseMode::Prefetch == r->mode) {
+            for(int j = i; j < count && j < i + medi::reversePrefetchDepth(); ++j) {
+              if(!medi::prefetchReverse(handles[j], &queue)) {
+                break;
+              }
+              prefetched = true;
+            }
+          }
+          handles[i]->funcReverse(handles[i], &queue);
+        }
+
+        if(ReverseMode::Prefetch == r->mode && !prefetched) {
+          std::cout << "No handle was prefetched." << std::endl;
+        }
+      }
+
+      if(ReverseMode::Deferred == r->mode && 0 == queue.deferredCount) {
+        std::cout << "No adjoint update was deferred." << std::endl;
+      }
+      queue.completeDeferred();
+    }
+
+    static void forward(medi::HandleBase* handle, medi::AdjointInterface* adjointInterface) {
+      RecordedReverse* r = static_cast<RecordedReverse*>(handle);
+
+      for(medi::HandleBase* h : r->handles) {
+        h->funcForward(h, adjointInterface);
+      }
+    }
+};
+
+/**
+ * @brief The AD tool of the driver, the handles are collected instead of added to the tape.
+ */
+template<typename Tool>
+struct RecordingTool : public Tool {
+    mutable std::vector<medi::HandleBase*> handles;
+
+    RecordingTool(Tool const& tool) :
+      Tool(tool),
+      handles() {}
+
+    void addToolAction(medi::HandleBase* h) const {
+      if(nullptr != h) {
+        handles.push_back(h);
+      }
+    }
+
+    /**
+     * @brief Add the collected handles as one action to the tape of the AD tool.
+     */
+    void pushReverse(ReverseMode mode) {
+      if(!handles.empty()) {
+        Tool::addToolAction(new RecordedReverse(mode, handles));
+        handles.clear();
+      }
+    }
+};
+
+template<typename Type>
+struct RecordingType {
+    using Tool = typename Type::Tool;
+
+    RecordingTool<Tool> tool;
+    Type type;
+
+    RecordingType(Type* base) :
+      tool(base->getADTool()),
+      type(&tool, base->getMpiType(), base->getModifiedMpiType()) {}
+};
+
+/**
+ * @brief A copy of the datatype whose handles are collected by the test, see RecordingTool.
+ */
+template<typename Type>
+RecordingType<Type>& getRecordingType(Type* base) {
+  static RecordingType<Type> recording(base);
+
+  return recording;
+}
@@ -0,0 +1,62 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {101.0, 102.0, 103.0, 104.0, 105.0, 106.0, 107.0, 108.0, 109.0, 110.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  // the received values start at a byte displacement that is not a multiple of the extent if the alignment of the
+  // type is smaller than its size
+  alignas(NUMBER) char storage[11 * sizeof(NUMBER)];
+  int shift = (int)alignof(NUMBER);
+  NUMBER* recvbuf = reinterpret_cast<NUMBER*>(storage + shift);
+  for(int i = 0; i < 10; ++i) {
+    new (&recvbuf[i]) NUMBER();
+  }
+
+  int sendcounts[2] = {5, 5};
+  int sdispls[2] = {0, 5 * (int)sizeof(NUMBER)};
+  medi::AMPI_Datatype sendtypes[2] = {mpiNumberType, mpiNumberType};
+  int recvcounts[2] = {5, 5};
+  int rdispls[2] = {shift, shift + 5 * (int)sizeof(NUMBER)};
+  medi::AMPI_Datatype recvtypes[2] = {mpiNumberType, mpiNumberType};
+  medi::AMPI_Alltoallw(x, sendcounts, sdispls, sendtypes, storage, recvcounts, rdispls, recvtypes, MPI_COMM_WORLD);
+
+  for(int i = 0; i < 10; ++i) {
+    y[i] = recvbuf[i];
+    recvbuf[i].~NUMBER();
+  }
+}
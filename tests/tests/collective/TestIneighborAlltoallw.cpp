@@ -0,0 +1,97 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {101.0, 102.0, 103.0, 104.0, 105.0, 106.0, 107.0, 108.0, 109.0, 110.0}}};
+
+/* Edges: 0 -> 1, 0 -> 0, 1 -> 1. The in and out neighbors differ on both ranks. */
+static MPI_Comm getGraphComm() {
+  static MPI_Comm comm = MPI_COMM_NULL;
+  if(MPI_COMM_NULL == comm) {
+    int world_rank;
+    medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+    if(0 == world_rank) {
+      int sources[1] = {0};
+      int destinations[2] = {1, 0};
+      MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, 1, sources, MPI_UNWEIGHTED, 2, destinations, MPI_UNWEIGHTED,
+                                     MPI_INFO_NULL, 0, &comm);
+    } else {
+      int sources[2] = {0, 1};
+      int destinations[1] = {1};
+      MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, 2, sources, MPI_UNWEIGHTED, 1, destinations, MPI_UNWEIGHTED,
+                                     MPI_INFO_NULL, 0, &comm);
+    }
+  }
+
+  return comm;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+
+  for(int i = 0; i < 10; ++i) {
+    y[i] = 0.0;
+  }
+
+  medi::AMPI_Datatype pairType;
+  medi::AMPI_Type_create_contiguous(2, mpiNumberType, &pairType);
+  medi::AMPI_Type_commit(&pairType);
+
+  medi::AMPI_Request request;
+
+  // the block of 6 elements is sent as 3 elements of the constructed type
+  if(0 == world_rank) {
+    int sendcounts[2] = {4, 3};
+    MPI_Aint sdispls[2] = {0, 4 * (MPI_Aint)sizeof(NUMBER)};
+    medi::AMPI_Datatype sendtypes[2] = {mpiNumberType, pairType};
+    int recvcounts[1] = {6};
+    MPI_Aint rdispls[1] = {0};
+    medi::AMPI_Datatype recvtypes[1] = {mpiNumberType};
+    medi::AMPI_Ineighbor_alltoallw(x, sendcounts, sdispls, sendtypes, y, recvcounts, rdispls,
+                                   recvtypes, getGraphComm(), &request);
+  } else {
+    int sendcounts[1] = {3};
+    MPI_Aint sdispls[1] = {0};
+    medi::AMPI_Datatype sendtypes[1] = {pairType};
+    int recvcounts[2] = {4, 6};
+    MPI_Aint rdispls[2] = {0, 4 * (MPI_Aint)sizeof(NUMBER)};
+    medi::AMPI_Datatype recvtypes[2] = {mpiNumberType, mpiNumberType};
+    medi::AMPI_Ineighbor_alltoallw(x, sendcounts, sdispls, sendtypes, y, recvcounts, rdispls,
+                                   recvtypes, getGraphComm(), &request);
+  }
+
+  medi::AMPI_Wait(&request, AMPI_STATUS_IGNORE);
+
+  // We do not free the type here since it is required for the reverse evaluation
+  //medi::AMPI_Type_free(&pairType);
+}
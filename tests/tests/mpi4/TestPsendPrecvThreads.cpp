@@ -0,0 +1,81 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#include <toolDefines.h>
+
+#include <thread>
+#include <vector>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+
+  int const partitions = 5;
+  NUMBER buf[10];
+
+  medi::AMPI_Request request;
+  if(world_rank == 0) {
+    medi::AMPI_Psend_init(buf, partitions, 2, mpiNumberType, 1, 42, AMPI_COMM_WORLD, MPI_INFO_NULL, &request);
+  } else {
+    medi::AMPI_Precv_init(buf, partitions, 2, mpiNumberType, 0, 42, AMPI_COMM_WORLD, MPI_INFO_NULL, &request);
+  }
+
+  for(int iter = 0; iter < 2; ++iter) {
+    if(world_rank == 0) {
+      for(int i = 0; i < 10; ++i) {
+        buf[i] = (iter + 1) * x[i];
+      }
+    }
+
+    medi::AMPI_Start(&request);
+    if(world_rank == 0) {
+      // Each worker thread marks its partition as ready.
+      std::vector<std::thread> workers;
+      for(int p = 0; p < partitions; ++p) {
+        workers.emplace_back([p, &request]() { medi::AMPI_Pready(p, &request); });
+      }
+      for(std::thread& worker : workers) {
+        worker.join();
+      }
+    }
+    medi::AMPI_Wait(&request, AMPI_STATUS_IGNORE);
+
+    if(world_rank == 1) {
+      for(int i = 0; i < 10; ++i) {
+        y[i] += buf[i];
+      }
+    }
+  }
+
+  medi::AMPI_Request_free(&request);
+}
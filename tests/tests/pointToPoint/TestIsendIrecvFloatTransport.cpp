@@ -0,0 +1,53 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+
+  // The adjoint values are integers, they are exact in the reduced precision.
+  medi::setAdjointTransportPrecision(AMPI_COMM_WORLD, medi::AdjointTransportPrecision::Float);
+
+  medi::AMPI_Request requests[2];
+  if(world_rank == 0) {
+    medi::AMPI_Isend(x, 5, mpiNumberType, 1, 42, AMPI_COMM_WORLD, &requests[0]);
+    medi::AMPI_Isend(&x[5], 5, mpiNumberType, 1, 43, AMPI_COMM_WORLD, &requests[1]);
+  } else {
+    medi::AMPI_Irecv(y, 5, mpiNumberType, 0, 42, AMPI_COMM_WORLD, &requests[0]);
+    medi::AMPI_Irecv(&y[5], 5, mpiNumberType, 0, 43, AMPI_COMM_WORLD, &requests[1]);
+  }
+
+  medi::AMPI_Waitall(2, requests, AMPI_STATUSES_IGNORE);
+}
@@ -0,0 +1,63 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2015-2025 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://scicomp.rptu.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of MeDiPack (http://scicomp.rptu.de/software/medi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU
+ * Lesser General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, University of Kaiserslautern-Landau)
+ */
+
+#include <toolDefines.h>
+#include "../../helpers/reverseHooks.hpp"
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  // The reverse action of the test posts the adjoint receives of the next four sends in advance.
+  medi::setReversePrefetchDepth(4);
+  auto& recording = getRecordingType(TOOL->MPI_TYPE);
+
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+
+  // all messages have the same tag, the adjoint receives have to be posted in the order of the reverse evaluation
+  if(0 == world_rank) {
+    for(int i = 0; i < 10; ++i) {
+      medi::AMPI_Send(&x[i], 1, &recording.type, 1, 42, AMPI_COMM_WORLD);
+    }
+    for(int i = 0; i < 10; ++i) {
+      medi::AMPI_Recv(&y[i], 1, &recording.type, 1, 42, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+    }
+  } else {
+    for(int i = 0; i < 10; ++i) {
+      medi::AMPI_Recv(&y[i], 1, &recording.type, 0, 42, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+    }
+    for(int i = 0; i < 10; ++i) {
+      medi::AMPI_Send(&x[i], 1, &recording.type, 0, 42, AMPI_COMM_WORLD);
+    }
+  }
+
+  recording.tool.pushReverse(ReverseMode::Prefetch);
+}